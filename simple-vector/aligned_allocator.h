@@ -0,0 +1,146 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Аллокаторы для SimpleVector с усиленным выравниванием. Подставляются параметром Alloc:
+//     SimpleVector<float, AlignedAllocator<float, 64>> v;
+// Так начало буфера совпадает с началом кэш-линии, и векторные загрузки по первым элементам не пересекают её границу
+
+// Выделяет память, выровненную на Alignment байт (степень двойки, не меньше alignof(Type))
+template <typename Type, size_t Alignment = 64>
+class AlignedAllocator {
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(Type), "Alignment must not be weaker than alignof(Type)");
+
+public:
+    using value_type = Type;
+    using is_always_equal = std::true_type;
+
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment>&) noexcept {}
+
+    Type* allocate(size_t count) {
+        if (count > SIZE_MAX / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(::operator new(count * sizeof(Type), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(Type* buffer, size_t /*count*/) noexcept {
+        ::operator delete(buffer, std::align_val_t(Alignment));
+    }
+};
+
+template <typename Lhs, typename Rhs, size_t Alignment>
+bool operator==(const AlignedAllocator<Lhs, Alignment>&, const AlignedAllocator<Rhs, Alignment>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs, size_t Alignment>
+bool operator!=(const AlignedAllocator<Lhs, Alignment>&, const AlignedAllocator<Rhs, Alignment>&) noexcept {
+    return false;
+}
+
+// Буферы от Threshold байт выделяет отдельным отображением, выровненным на 2 МБ, и просит ядро
+// разместить его на прозрачных огромных страницах (madvise(MADV_HUGEPAGE)). Это снижает число промахов TLB
+// при проходах по большим векторам. Меньшие буферы выделяются как в AlignedAllocator<Type, 64>.
+// Хвост последней огромной страницы можно отдать под элементы политикой PageRoundedGrowth<DoublingGrowth, 2 << 20>.
+// Вне Linux ведёт себя как AlignedAllocator
+template <typename Type, size_t Threshold = (size_t(2) << 20)>
+class HugePageAllocator {
+public:
+    using value_type = Type;
+    using is_always_equal = std::true_type;
+
+    static constexpr size_t kHugePageSize = size_t(2) << 20;
+
+    template <typename Other>
+    struct rebind {
+        using other = HugePageAllocator<Other, Threshold>;
+    };
+
+    HugePageAllocator() noexcept = default;
+
+    template <typename Other>
+    HugePageAllocator(const HugePageAllocator<Other, Threshold>&) noexcept {}
+
+    Type* allocate(size_t count) {
+        if (count > SIZE_MAX / sizeof(Type) - kHugePageSize) {
+            throw std::bad_array_new_length();
+        }
+#if defined(__linux__)
+        const size_t bytes = count * sizeof(Type);
+        if (bytes >= Threshold) {
+            return static_cast<Type*>(MapHugePages(RoundToHugePages(bytes)));
+        }
+#endif
+        return Small().allocate(count);
+    }
+
+    void deallocate(Type* buffer, size_t count) noexcept {
+#if defined(__linux__)
+        const size_t bytes = count * sizeof(Type);
+        if (bytes >= Threshold) {
+            ::munmap(buffer, RoundToHugePages(bytes));
+            return;
+        }
+#endif
+        Small().deallocate(buffer, count);
+    }
+
+private:
+    static AlignedAllocator<Type, (alignof(Type) > 64 ? alignof(Type) : 64)> Small() noexcept {
+        return {};
+    }
+
+#if defined(__linux__)
+    static size_t RoundToHugePages(size_t bytes) noexcept {
+        return (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    }
+
+    // mmap выравнивает только на обычную страницу, поэтому берём на одну огромную страницу больше
+    // и отрезаем лишнее с обоих концов
+    static void* MapHugePages(size_t bytes) {
+        void* mapping = ::mmap(nullptr, bytes + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        const auto start = reinterpret_cast<uintptr_t>(mapping);
+        const uintptr_t aligned = (start + kHugePageSize - 1) & ~(uintptr_t(kHugePageSize) - 1);
+        if (aligned != start) {
+            ::munmap(mapping, aligned - start);
+        }
+        const size_t tail = kHugePageSize - (aligned - start);
+        if (tail != 0) {
+            ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+        }
+        void* result = reinterpret_cast<void*>(aligned);
+        // Без поддержки THP в ядре подсказка не сработает, но память останется пригодной
+        ::madvise(result, bytes, MADV_HUGEPAGE);
+        return result;
+    }
+#endif
+};
+
+template <typename Lhs, typename Rhs, size_t Threshold>
+bool operator==(const HugePageAllocator<Lhs, Threshold>&, const HugePageAllocator<Rhs, Threshold>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs, size_t Threshold>
+bool operator!=(const HugePageAllocator<Lhs, Threshold>&, const HugePageAllocator<Rhs, Threshold>&) noexcept {
+    return false;
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// BatchExchange — передача пакетов SimpleVector от одного потока-производителя одному потоку-потребителю
+// без блокировок и без выделения памяти в установившемся режиме.
+// Пакеты не перемещаются в новый вектор, а обмениваются через swap с единственной ячейкой обмена:
+// производитель отдаёт заполненный пакет и получает взамен пустой вектор, который потребитель уже обработал,
+// вместе с его вместимостью. В обороте всегда три вектора (у производителя, в ячейке и у потребителя),
+// поэтому после того, как каждый из них один раз вырос до размера пакета, память больше не выделяется.
+//
+// TryPublish вызывает только производитель, TryTake — только потребитель; оба не ждут: если ячейка занята
+// (потребитель ещё не забрал прошлый пакет) или пуста, они возвращают false. Publish и Take ждут, уступая процессор.
+// После Close потребитель получает оставшийся пакет, а затем Take возвращает false.
+// Типичный цикл потребителя:
+//     SimpleVector<Type> batch;
+//     while (exchange.Take(batch)) { Process(batch); }
+template <typename Type, typename Alloc = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth, typename Stats = NoStats>
+class BatchExchange {
+public:
+    using Batch = SimpleVector<Type, Alloc, GrowthPolicy, Stats>;
+
+    // batch_capacity — вместимость, которую сразу получает вектор в ячейке обмена
+    explicit BatchExchange(size_t batch_capacity = 0, const Alloc& alloc = Alloc())
+        : slot_(alloc)
+    {
+        slot_.Reserve(batch_capacity);
+    }
+
+    // Ячейку обмена используют два потока, поэтому её нельзя ни копировать, ни перемещать
+    BatchExchange(const BatchExchange&) = delete;
+    BatchExchange& operator=(const BatchExchange&) = delete;
+
+    // Отдаёт batch потребителю, если он забрал предыдущий пакет. В этом случае batch становится пустым вектором
+    // с вместимостью ранее обработанного пакета. Иначе возвращает false и ничего не меняет
+    bool TryPublish(Batch& batch) noexcept {
+        if (state_.load(std::memory_order_acquire) != SlotState::kEmpty) {
+            return false;
+        }
+        slot_.swap(batch);
+        state_.store(SlotState::kFull, std::memory_order_release);
+        return true;
+    }
+
+    // Ждёт, пока потребитель заберёт предыдущий пакет, и отдаёт batch
+    void Publish(Batch& batch) noexcept {
+        while (!TryPublish(batch)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Сообщает потребителю, что пакетов больше не будет. Вызывает производитель после последнего Publish
+    void Close() noexcept {
+        closed_.store(true, std::memory_order_release);
+    }
+
+    // Забирает опубликованный пакет в batch, если он есть. Прежние элементы batch разрушаются,
+    // а его память уходит производителю для следующих пакетов. Иначе возвращает false и ничего не меняет
+    bool TryTake(Batch& batch) noexcept {
+        if (state_.load(std::memory_order_acquire) != SlotState::kFull) {
+            return false;
+        }
+        batch.Clear();
+        slot_.swap(batch);
+        state_.store(SlotState::kEmpty, std::memory_order_release);
+        return true;
+    }
+
+    // Ждёт следующий пакет. Возвращает false, если производитель вызвал Close и все пакеты уже забраны
+    bool Take(Batch& batch) noexcept {
+        while (!TryTake(batch)) {
+            if (closed_.load(std::memory_order_acquire)) {
+                // Пакет мог быть опубликован между неудачной попыткой и Close
+                return TryTake(batch);
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    bool IsClosed() const noexcept {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+private:
+    enum class SlotState : unsigned char {
+        // В ячейке пустой вектор: его заберёт следующий TryPublish
+        kEmpty,
+        // В ячейке опубликованный пакет: его заберёт следующий TryTake
+        kFull,
+    };
+
+    Batch slot_;
+    std::atomic<SlotState> state_{ SlotState::kEmpty };
+    std::atomic<bool> closed_{ false };
+};
+
+// Копит элементы в пакет и публикует его через BatchExchange, как только в нём batch_size элементов.
+// Принадлежит потоку-производителю. Неполный последний пакет отдаёт Flush или Close
+template <typename Type, typename Alloc = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth, typename Stats = NoStats>
+class BatchProducer {
+public:
+    using Exchange = BatchExchange<Type, Alloc, GrowthPolicy, Stats>;
+    using Batch = typename Exchange::Batch;
+
+    BatchProducer(Exchange& exchange, size_t batch_size, const Alloc& alloc = Alloc())
+        : exchange_(exchange)
+        , batch_size_(batch_size)
+        , batch_(alloc)
+    {
+        assert(batch_size != 0);
+        batch_.Reserve(batch_size_);
+    }
+
+    BatchProducer(const BatchProducer&) = delete;
+    BatchProducer& operator=(const BatchProducer&) = delete;
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в текущем пакете. Заполненный пакет публикуется, и вызов ждёт, пока потребитель заберёт предыдущий
+    template <typename... Args>
+    void EmplaceBack(Args&&... args) {
+        batch_.EmplaceBack(std::forward<Args>(args)...);
+        if (batch_.GetSize() >= batch_size_) {
+            Flush();
+        }
+    }
+
+    // Публикует накопленные элементы, даже если пакет неполный. Пустой пакет не публикуется
+    void Flush() {
+        if (batch_.IsEmpty()) {
+            return;
+        }
+        exchange_.Publish(batch_);
+        // Вернувшийся вектор мог ещё не дорасти до размера пакета: память выделяется один раз, а не по мере удвоения
+        batch_.Reserve(batch_size_);
+    }
+
+    // Публикует остаток и закрывает обмен
+    void Close() {
+        Flush();
+        exchange_.Close();
+    }
+
+    // Количество элементов, ещё не отданных потребителю
+    size_t GetPendingSize() const noexcept {
+        return batch_.GetSize();
+    }
+
+private:
+    Exchange& exchange_;
+    size_t batch_size_;
+    Batch batch_;
+};
+
+// Итератор вывода, добавляющий присваиваемые значения в конец контейнера через PushBack.
+// Подходит для SimpleVector и BatchProducer, например std::copy(first, last, BackInserter(producer))
+template <typename Container>
+class BackInsertIterator {
+public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    explicit BackInsertIterator(Container& container) noexcept
+        : container_(&container)
+    {}
+
+    template <typename Value, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Value>, BackInsertIterator>>>
+    BackInsertIterator& operator=(Value&& value) {
+        container_->PushBack(std::forward<Value>(value));
+        return *this;
+    }
+
+    BackInsertIterator& operator*() noexcept {
+        return *this;
+    }
+
+    BackInsertIterator& operator++() noexcept {
+        return *this;
+    }
+
+    BackInsertIterator operator++(int) noexcept {
+        return *this;
+    }
+
+private:
+    Container* container_;
+};
+
+template <typename Container>
+BackInsertIterator<Container> BackInserter(Container& container) noexcept {
+    return BackInsertIterator<Container>(container);
+}
@@ -0,0 +1,365 @@
+// Задержки отдельных операций SimpleVector: перцентили p50/p99/p99.9/max и пик RSS при перевыделениях.
+// В отличие от simple_vector_benchmark.cpp, здесь важна не средняя пропускная способность, а худшие паузы,
+// которые случаются, когда PushBack упирается во вместимость и переносит все элементы.
+//
+// Сборка и запуск:
+//     g++ -std=c++17 -O2 -DNDEBUG -I.. latency_benchmark.cpp -o latency_benchmark
+//     ./latency_benchmark                         # таблица
+//     ./latency_benchmark --json > latency.json   # машиночитаемый отчёт для сравнения сборок
+//     ./latency_benchmark --max-pause-us=20000    # код возврата 1, если хоть одна операция дольше порога
+//     ./latency_benchmark --scale=0.1             # уменьшает размеры для быстрой проверки
+//
+// Каждый сценарий (PushBack, Insert, Reserve) запускается для int, std::string и 64-байтовой записи
+// с политиками роста DoublingGrowth, OneAndHalfGrowth и GoldenRatioGrowth. Сценарий выполняется дважды:
+// первый прогон измеряет время каждой операции, второй с политикой статистики RssProbe замеряет RSS
+// в момент перевыделения, когда старый и новый блоки ещё живы, и не искажает задержки чтением /proc
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 64-байтовая тривиально копируемая запись
+struct Record64 {
+    int64_t fields[8];
+};
+
+template <typename Type>
+Type MakeValue(size_t i);
+
+template <>
+int MakeValue<int>(size_t i) {
+    return static_cast<int>(i);
+}
+
+template <>
+std::string MakeValue<std::string>(size_t i) {
+    // Длиннее буфера малых строк, чтобы каждая строка владела памятью в куче
+    return std::string(32, static_cast<char>('a' + i % 26));
+}
+
+template <>
+Record64 MakeValue<Record64>(size_t i) {
+    Record64 record{};
+    record.fields[0] = static_cast<int64_t>(i);
+    return record;
+}
+
+// Не даёт компилятору выбросить работу, результат которой не используется
+void Escape(const void* pointer) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(pointer) : "memory");
+#else
+    static const void* volatile sink;
+    sink = pointer;
+#endif
+}
+
+// Текущий RSS процесса в байтах или 0, если платформа его не сообщает
+uint64_t CurrentRss() {
+#if defined(__linux__)
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr) {
+        return 0;
+    }
+    unsigned long long total_pages = 0;
+    unsigned long long resident_pages = 0;
+    const int read = std::fscanf(statm, "%llu %llu", &total_pages, &resident_pages);
+    std::fclose(statm);
+    return read == 2 ? resident_pages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+    return 0;
+#endif
+}
+
+// Политика статистики, запоминающая наибольший RSS в момент переноса элементов.
+// OnRelocate вызывается, когда элементы уже перенесены, а старый блок ещё не освобождён
+struct RssProbe {
+    static inline uint64_t peak = 0;
+
+    static void OnAllocate(size_t /*old_capacity*/, size_t /*new_capacity*/, size_t /*element_size*/) noexcept {}
+
+    static void OnRelocate(size_t /*count*/, size_t /*element_size*/) noexcept {
+        peak = std::max(peak, CurrentRss());
+    }
+
+    static void OnCopy(size_t /*count*/, size_t /*element_size*/) noexcept {}
+};
+
+struct Options {
+    double scale = 1.0;
+    bool json = false;
+    // 0 — без проверки
+    uint64_t max_pause_ns = 0;
+};
+
+struct Result {
+    std::string name;
+    size_t operations = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    uint64_t max_ns = 0;
+    double total_ms = 0;
+    uint64_t baseline_rss_bytes = 0;
+    uint64_t peak_rss_bytes = 0;
+};
+
+// Задержки операций одного прогона. Память под замеры выделяется заранее, чтобы запись замера не меняла картину
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(size_t operations) {
+        samples_.Reserve(operations);
+    }
+
+    template <typename Operation>
+    void Measure(Operation operation) {
+        const auto start = std::chrono::steady_clock::now();
+        operation();
+        const auto finish = std::chrono::steady_clock::now();
+        samples_.PushBack(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count()));
+    }
+
+    void Summarize(Result& result) {
+        std::sort(samples_.begin(), samples_.end());
+        result.operations = samples_.GetSize();
+        if (samples_.IsEmpty()) {
+            return;
+        }
+        result.p50_ns = Percentile(0.5);
+        result.p99_ns = Percentile(0.99);
+        result.p999_ns = Percentile(0.999);
+        result.max_ns = samples_[samples_.GetSize() - 1];
+        uint64_t total = 0;
+        for (uint64_t sample : samples_) {
+            total += sample;
+        }
+        result.total_ms = static_cast<double>(total) / 1e6;
+    }
+
+private:
+    SimpleVector<uint64_t> samples_;
+
+    uint64_t Percentile(double quantile) const {
+        const size_t index = static_cast<size_t>(quantile * static_cast<double>(samples_.GetSize()));
+        return samples_[std::min(index, samples_.GetSize() - 1)];
+    }
+};
+
+template <typename Type, typename GrowthPolicy, typename Stats = NoStats>
+using BenchVector = SimpleVector<Type, std::allocator<Type>, GrowthPolicy, Stats>;
+
+// Добавление count элементов в пустой вектор: пауза каждого перевыделения видна в хвосте распределения
+template <typename Type, typename GrowthPolicy>
+struct PushBackScenario {
+    static constexpr const char* kName = "PushBack";
+
+    template <typename Stats>
+    static void Run(size_t base, LatencyRecorder* recorder) {
+        BenchVector<Type, GrowthPolicy, Stats> v;
+        for (size_t i = 0; i < base; ++i) {
+            Type value = MakeValue<Type>(i);
+            if (recorder != nullptr) {
+                recorder->Measure([&] {
+                    v.PushBack(std::move(value));
+                });
+            }
+            else {
+                v.PushBack(std::move(value));
+            }
+        }
+        Escape(v.begin());
+    }
+
+    static size_t Operations(size_t base) {
+        return base;
+    }
+};
+
+// Вставка в середину: каждая операция сдвигает половину элементов, переполнение дополнительно переносит все
+template <typename Type, typename GrowthPolicy>
+struct InsertScenario {
+    static constexpr const char* kName = "Insert";
+
+    template <typename Stats>
+    static void Run(size_t base, LatencyRecorder* recorder) {
+        BenchVector<Type, GrowthPolicy, Stats> v;
+        for (size_t i = 0; i < Operations(base); ++i) {
+            Type value = MakeValue<Type>(i);
+            auto insert = [&] {
+                v.Insert(v.begin() + v.GetSize() / 2, std::move(value));
+            };
+            if (recorder != nullptr) {
+                recorder->Measure(insert);
+            }
+            else {
+                insert();
+            }
+        }
+        Escape(v.begin());
+    }
+
+    static size_t Operations(size_t base) {
+        return std::max<size_t>(base / 256, 1);
+    }
+};
+
+// Reserve заполненного вектора до удвоенной вместимости: одна операция — один перенос всех элементов
+template <typename Type, typename GrowthPolicy>
+struct ReserveScenario {
+    static constexpr const char* kName = "Reserve";
+    static constexpr size_t kRounds = 64;
+
+    template <typename Stats>
+    static void Run(size_t base, LatencyRecorder* recorder) {
+        const size_t size = std::max<size_t>(base / kRounds, 1);
+        for (size_t round = 0; round < kRounds; ++round) {
+            BenchVector<Type, GrowthPolicy, Stats> v;
+            v.Reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                v.PushBack(MakeValue<Type>(i));
+            }
+            if (recorder != nullptr) {
+                recorder->Measure([&] {
+                    v.Reserve(size * 2);
+                });
+            }
+            else {
+                v.Reserve(size * 2);
+            }
+            Escape(v.begin());
+        }
+    }
+
+    static size_t Operations(size_t /*base*/) {
+        return kRounds;
+    }
+};
+
+template <template <typename, typename> typename Scenario, typename Type, typename GrowthPolicy>
+Result RunScenario(size_t base, const char* type_name, const char* policy_name) {
+    using Current = Scenario<Type, GrowthPolicy>;
+    Result result;
+    result.name = std::string(Current::kName) + "/" + type_name + "/" + policy_name;
+
+    LatencyRecorder recorder(Current::Operations(base));
+    Current::template Run<NoStats>(base, &recorder);
+    recorder.Summarize(result);
+
+    result.baseline_rss_bytes = CurrentRss();
+    RssProbe::peak = result.baseline_rss_bytes;
+    Current::template Run<RssProbe>(base, nullptr);
+    result.peak_rss_bytes = RssProbe::peak;
+    return result;
+}
+
+template <template <typename, typename> typename Scenario, typename Type>
+void RunPolicies(size_t base, const char* type_name, SimpleVector<Result>& results) {
+    results.PushBack(RunScenario<Scenario, Type, DoublingGrowth>(base, type_name, "DoublingGrowth"));
+    results.PushBack(RunScenario<Scenario, Type, OneAndHalfGrowth>(base, type_name, "OneAndHalfGrowth"));
+    results.PushBack(RunScenario<Scenario, Type, GoldenRatioGrowth>(base, type_name, "GoldenRatioGrowth"));
+}
+
+template <template <typename, typename> typename Scenario>
+void RunTypes(const Options& options, SimpleVector<Result>& results) {
+    auto scaled = [&options](size_t size) {
+        return std::max<size_t>(static_cast<size_t>(static_cast<double>(size) * options.scale), 1);
+    };
+    RunPolicies<Scenario, int>(scaled(size_t(1) << 22), "int", results);
+    RunPolicies<Scenario, Record64>(scaled(size_t(1) << 20), "Record64", results);
+    RunPolicies<Scenario, std::string>(scaled(size_t(1) << 20), "string", results);
+}
+
+void PrintTable(const SimpleVector<Result>& results) {
+    std::printf("%-36s %10s %10s %10s %10s %12s %10s %12s\n", "scenario", "ops", "p50_ns", "p99_ns", "p99.9_ns", "max_ns",
+                "total_ms", "peak_rss_mb");
+    for (const Result& result : results) {
+        std::printf("%-36s %10zu %10llu %10llu %10llu %12llu %10.1f %12.1f\n", result.name.c_str(), result.operations,
+                    static_cast<unsigned long long>(result.p50_ns), static_cast<unsigned long long>(result.p99_ns),
+                    static_cast<unsigned long long>(result.p999_ns), static_cast<unsigned long long>(result.max_ns), result.total_ms,
+                    static_cast<double>(result.peak_rss_bytes) / (1 << 20));
+    }
+}
+
+void PrintJson(const SimpleVector<Result>& results) {
+    std::printf("{\n  \"scenarios\": [\n");
+    for (size_t i = 0; i < results.GetSize(); ++i) {
+        const Result& result = results[i];
+        std::printf("    {\"name\": \"%s\", \"operations\": %zu, \"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, "
+                    "\"max_ns\": %llu, \"total_ms\": %.3f, \"baseline_rss_bytes\": %llu, \"peak_rss_bytes\": %llu}%s\n",
+                    result.name.c_str(), result.operations, static_cast<unsigned long long>(result.p50_ns),
+                    static_cast<unsigned long long>(result.p99_ns), static_cast<unsigned long long>(result.p999_ns),
+                    static_cast<unsigned long long>(result.max_ns), result.total_ms,
+                    static_cast<unsigned long long>(result.baseline_rss_bytes), static_cast<unsigned long long>(result.peak_rss_bytes),
+                    i + 1 == results.GetSize() ? "" : ",");
+    }
+    std::printf("  ]\n}\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--json") == 0) {
+            options.json = true;
+        }
+        else if (std::strncmp(arg, "--scale=", 8) == 0) {
+            options.scale = std::atof(arg + 8);
+            if (options.scale <= 0) {
+                std::fprintf(stderr, "--scale must be positive\n");
+                return false;
+            }
+        }
+        else if (std::strncmp(arg, "--max-pause-us=", 15) == 0) {
+            options.max_pause_ns = std::strtoull(arg + 15, nullptr, 10) * 1000;
+        }
+        else {
+            std::fprintf(stderr, "usage: %s [--json] [--scale=X] [--max-pause-us=N]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    SimpleVector<Result> results;
+    RunTypes<PushBackScenario>(options, results);
+    RunTypes<InsertScenario>(options, results);
+    RunTypes<ReserveScenario>(options, results);
+
+    if (options.json) {
+        PrintJson(results);
+    }
+    else {
+        PrintTable(results);
+    }
+
+    int status = 0;
+    if (options.max_pause_ns != 0) {
+        for (const Result& result : results) {
+            if (result.max_ns > options.max_pause_ns) {
+                std::fprintf(stderr, "%s: max pause %llu ns exceeds %llu ns\n", result.name.c_str(),
+                             static_cast<unsigned long long>(result.max_ns), static_cast<unsigned long long>(options.max_pause_ns));
+                status = 1;
+            }
+        }
+    }
+    return status;
+}
@@ -0,0 +1,276 @@
+// Сравнение производительности SimpleVector и std::vector (Google Benchmark).
+//
+// Сборка и запуск:
+//     g++ -std=c++17 -O2 -DNDEBUG -I.. simple_vector_benchmark.cpp -lbenchmark -lpthread -o simple_vector_benchmark
+//     ./simple_vector_benchmark --benchmark_filter=PushBack
+//
+// Каждый сценарий запускается для SimpleVector и std::vector с одинаковыми типами элементов:
+// int, std::string, 64-байтовая запись и некопируемый MoveOnly. Размеры для дешёвых типов доходят до 10^8,
+// для тяжёлых ограничены, чтобы прогон помещался в память разумной машины
+
+#include "simple_vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// 64-байтовая тривиально копируемая запись
+struct Record64 {
+    int64_t fields[8];
+};
+
+// Аналог X из main.cpp: только перемещение
+class MoveOnly {
+public:
+    explicit MoveOnly(size_t value = 0)
+        : value_(value) {
+    }
+    MoveOnly(const MoveOnly&) = delete;
+    MoveOnly& operator=(const MoveOnly&) = delete;
+    MoveOnly(MoveOnly&& other) noexcept
+        : value_(std::exchange(other.value_, 0)) {
+    }
+    MoveOnly& operator=(MoveOnly&& other) noexcept {
+        value_ = std::exchange(other.value_, 0);
+        return *this;
+    }
+    size_t GetValue() const {
+        return value_;
+    }
+
+private:
+    size_t value_;
+};
+
+template <typename Type>
+Type MakeValue(size_t i);
+
+template <>
+int MakeValue<int>(size_t i) {
+    return static_cast<int>(i);
+}
+
+template <>
+std::string MakeValue<std::string>(size_t i) {
+    // Длина выходит за пределы small string optimization, поэтому строка живёт в куче
+    return "benchmark value number " + std::to_string(i);
+}
+
+template <>
+Record64 MakeValue<Record64>(size_t i) {
+    Record64 record{};
+    record.fields[0] = static_cast<int64_t>(i);
+    return record;
+}
+
+template <>
+MoveOnly MakeValue<MoveOnly>(size_t i) {
+    return MoveOnly(i);
+}
+
+// Единый интерфейс над SimpleVector и std::vector
+template <typename Type>
+void Append(SimpleVector<Type>& v, Type&& value) {
+    v.PushBack(std::move(value));
+}
+
+template <typename Type>
+void Append(std::vector<Type>& v, Type&& value) {
+    v.push_back(std::move(value));
+}
+
+template <typename Type>
+void ReserveFor(SimpleVector<Type>& v, size_t capacity) {
+    v.Reserve(capacity);
+}
+
+template <typename Type>
+void ReserveFor(std::vector<Type>& v, size_t capacity) {
+    v.reserve(capacity);
+}
+
+template <typename Type>
+void InsertAt(SimpleVector<Type>& v, size_t index, Type&& value) {
+    v.Insert(v.begin() + index, std::move(value));
+}
+
+template <typename Type>
+void InsertAt(std::vector<Type>& v, size_t index, Type&& value) {
+    v.insert(v.begin() + index, std::move(value));
+}
+
+template <typename Type>
+void EraseAt(SimpleVector<Type>& v, size_t index) {
+    v.Erase(v.begin() + index);
+}
+
+template <typename Type>
+void EraseAt(std::vector<Type>& v, size_t index) {
+    v.erase(v.begin() + index);
+}
+
+template <typename Type>
+size_t SizeOf(const SimpleVector<Type>& v) {
+    return v.GetSize();
+}
+
+template <typename Type>
+size_t SizeOf(const std::vector<Type>& v) {
+    return v.size();
+}
+
+template <typename Container>
+using ValueOf = std::decay_t<decltype(*std::declval<Container&>().begin())>;
+
+template <typename Container>
+Container MakeFilled(size_t size) {
+    Container v;
+    ReserveFor(v, size);
+    for (size_t i = 0; i < size; ++i) {
+        Append(v, MakeValue<ValueOf<Container>>(i));
+    }
+    return v;
+}
+
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 0; i < size; ++i) {
+            Append(v, MakeValue<ValueOf<Container>>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_ReserveAndFill(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Container v = MakeFilled<Container>(size);
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Позиция вставки: 0 — в начало, 1 — в середину, 2 — в конец
+template <typename Container>
+void BM_Insert(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const auto where = state.range(1);
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 0; i < size; ++i) {
+            const size_t current = SizeOf(v);
+            const size_t index = where == 0 ? 0 : where == 1 ? current / 2 : current;
+            InsertAt(v, index, MakeValue<ValueOf<Container>>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_Erase(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container v = MakeFilled<Container>(size);
+        state.ResumeTiming();
+        while (SizeOf(v) != 0) {
+            EraseAt(v, SizeOf(v) / 2);
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_Copy(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container source = MakeFilled<Container>(size);
+    for (auto _ : state) {
+        Container copy(source);
+        benchmark::DoNotOptimize(copy.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_Move(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    Container source = MakeFilled<Container>(size);
+    for (auto _ : state) {
+        Container moved(std::move(source));
+        benchmark::DoNotOptimize(moved.begin());
+        source = std::move(moved);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    Container v = MakeFilled<Container>(size);
+    for (auto _ : state) {
+        for (auto& item : v) {
+            benchmark::DoNotOptimize(&item);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Верхние границы размеров для каждого типа
+constexpr int64_t kMaxCheapSize = 100'000'000;
+constexpr int64_t kMaxRecordSize = 10'000'000;
+constexpr int64_t kMaxHeavySize = 1'000'000;
+// Вставка и удаление в середине квадратичны, поэтому для них размеры меньше
+constexpr int64_t kMaxShiftingSize = 10'000;
+
+template <int64_t MaxSize>
+void Sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(10)->Range(1, MaxSize)->Unit(benchmark::kMicrosecond);
+}
+
+void InsertPositions(benchmark::internal::Benchmark* b) {
+    for (int64_t where = 0; where < 3; ++where) {
+        for (int64_t size = 1; size <= kMaxShiftingSize; size *= 10) {
+            b->Args({ size, where });
+        }
+    }
+    b->Unit(benchmark::kMicrosecond);
+}
+
+} // namespace
+
+#define SIMPLE_VECTOR_BENCHMARKS_MOVABLE(Container, MaxSize)                        \
+    BENCHMARK_TEMPLATE(BM_PushBack, Container)->Apply(Sizes<MaxSize>);              \
+    BENCHMARK_TEMPLATE(BM_ReserveAndFill, Container)->Apply(Sizes<MaxSize>);        \
+    BENCHMARK_TEMPLATE(BM_Insert, Container)->Apply(InsertPositions);               \
+    BENCHMARK_TEMPLATE(BM_Erase, Container)->Apply(Sizes<kMaxShiftingSize>);       \
+    BENCHMARK_TEMPLATE(BM_Move, Container)->Apply(Sizes<MaxSize>);                  \
+    BENCHMARK_TEMPLATE(BM_Iterate, Container)->Apply(Sizes<MaxSize>)
+
+#define SIMPLE_VECTOR_BENCHMARKS(Container, MaxSize)                                \
+    SIMPLE_VECTOR_BENCHMARKS_MOVABLE(Container, MaxSize);                           \
+    BENCHMARK_TEMPLATE(BM_Copy, Container)->Apply(Sizes<MaxSize>)
+
+SIMPLE_VECTOR_BENCHMARKS(SimpleVector<int>, kMaxCheapSize);
+SIMPLE_VECTOR_BENCHMARKS(std::vector<int>, kMaxCheapSize);
+SIMPLE_VECTOR_BENCHMARKS(SimpleVector<Record64>, kMaxRecordSize);
+SIMPLE_VECTOR_BENCHMARKS(std::vector<Record64>, kMaxRecordSize);
+SIMPLE_VECTOR_BENCHMARKS(SimpleVector<std::string>, kMaxHeavySize);
+SIMPLE_VECTOR_BENCHMARKS(std::vector<std::string>, kMaxHeavySize);
+SIMPLE_VECTOR_BENCHMARKS_MOVABLE(SimpleVector<MoveOnly>, kMaxHeavySize);
+SIMPLE_VECTOR_BENCHMARKS_MOVABLE(std::vector<MoveOnly>, kMaxHeavySize);
+
+BENCHMARK_MAIN();
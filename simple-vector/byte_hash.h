@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace detail {
+
+// Константы смешивания хеша: нечётные 64-битные числа с равным количеством единичных бит
+inline constexpr uint64_t kHashSecret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull,
+};
+
+// Полное 128-битное произведение a и b: младшая половина остаётся в a, старшая — в b
+inline void MultiplyFull(uint64_t& a, uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t product = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+#else
+    const uint64_t a_high = a >> 32, a_low = static_cast<uint32_t>(a);
+    const uint64_t b_high = b >> 32, b_low = static_cast<uint32_t>(b);
+    const uint64_t low = a_low * b_low, middle1 = a_high * b_low, middle2 = a_low * b_high, high = a_high * b_high;
+    const uint64_t carry = ((low >> 32) + static_cast<uint32_t>(middle1) + static_cast<uint32_t>(middle2)) >> 32;
+    a = low + (middle1 << 32) + (middle2 << 32);
+    b = high + (middle1 >> 32) + (middle2 >> 32) + carry;
+#endif
+}
+
+// Перемешивает два слова в одно: xor младшей и старшей половин их произведения
+inline uint64_t HashMix(uint64_t a, uint64_t b) noexcept {
+    MultiplyFull(a, b);
+    return a ^ b;
+}
+
+inline uint64_t ReadHashWord(const unsigned char* p) noexcept {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t ReadHashHalfWord(const unsigned char* p) noexcept {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Некриптографический хеш size байт по схеме wyhash. Длинные данные обрабатываются по 48 байт за шаг
+// в трёх независимых цепочках умножений, которые процессор выполняет параллельно, поэтому скорость
+// близка к пропускной способности памяти без SIMD-инструкций. Короткие ключи (до 16 байт) читаются без циклов.
+// Результат зафиксирован: он зависит только от байтов, size, seed и порядка байт платформы, одинаков у всех
+// реализаций MultiplyFull и не меняется между версиями. Поэтому его можно хранить, например как контрольную сумму
+// формата simple_vector_io.h; изменение алгоритма или констант требует новой версии этого формата
+inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0) noexcept {
+    const auto* p = static_cast<const unsigned char*>(data);
+    seed ^= HashMix(seed ^ kHashSecret[0], kHashSecret[1]);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (size <= 16) {
+        if (size >= 4) {
+            // Два перекрывающихся чтения по 4 байта с каждого края покрывают 4..16 байт
+            const size_t shift = (size >> 3) << 2;
+            a = (ReadHashHalfWord(p) << 32) | ReadHashHalfWord(p + shift);
+            b = (ReadHashHalfWord(p + size - 4) << 32) | ReadHashHalfWord(p + size - 4 - shift);
+        }
+        else if (size != 0) {
+            a = (uint64_t(p[0]) << 16) | (uint64_t(p[size >> 1]) << 8) | p[size - 1];
+        }
+    }
+    else {
+        size_t remaining = size;
+        if (remaining > 48) {
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do {
+                seed = HashMix(ReadHashWord(p) ^ kHashSecret[1], ReadHashWord(p + 8) ^ seed);
+                seed1 = HashMix(ReadHashWord(p + 16) ^ kHashSecret[2], ReadHashWord(p + 24) ^ seed1);
+                seed2 = HashMix(ReadHashWord(p + 32) ^ kHashSecret[3], ReadHashWord(p + 40) ^ seed2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16) {
+            seed = HashMix(ReadHashWord(p) ^ kHashSecret[1], ReadHashWord(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        // Последние 16 байт читаются целиком, заходя на уже обработанные
+        a = ReadHashWord(p + remaining - 16);
+        b = ReadHashWord(p + remaining - 8);
+    }
+    a ^= kHashSecret[1];
+    b ^= seed;
+    MultiplyFull(a, b);
+    return HashMix(a ^ kHashSecret[0] ^ size, b ^ kHashSecret[1]);
+}
+
+// Добавляет хеш очередного значения к накопленному seed. Порядок значений важен
+inline uint64_t HashCombine(uint64_t seed, uint64_t value) noexcept {
+    return HashMix(seed ^ kHashSecret[0], value ^ kHashSecret[1]);
+}
+
+} // namespace detail
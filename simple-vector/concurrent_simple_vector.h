@@ -0,0 +1,254 @@
+#pragma once
+
+#include "raw_storage.h"
+#include "simple_vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// ConcurrentSimpleVector — вектор, в который несколько потоков одновременно добавляют элементы без блокировок.
+// Ячейка для нового элемента резервируется атомарным увеличением размера, поэтому PushBack и EmplaceBack
+// не ждут других потоков. Элементы лежат в сегментах, каждый из которых вдвое больше предыдущего:
+// выделенный сегмент никогда не перемещается, и ссылки на элементы остаются действительными до разрушения вектора.
+//
+// Добавлять элементы можно из любых потоков одновременно. Читать элемент можно, если добавивший его PushBack
+// завершился раньше чтения (например, поток-производитель уже присоединён). Flatten, ToSimpleVector и разрушение
+// допустимы только после того, как все производители закончили работу.
+// Зарезервированную ячейку нельзя вернуть, поэтому нехватка памяти под новый сегмент завершает программу
+template <typename Type>
+class ConcurrentSimpleVector {
+    // Первый сегмент вмещает 2^kFirstSegmentBits элементов
+    static constexpr size_t kFirstSegmentBits = 5;
+    static constexpr size_t kFirstSegmentSize = size_t(1) << kFirstSegmentBits;
+    static constexpr size_t kSegmentCount = sizeof(size_t) * 8 - kFirstSegmentBits;
+
+public:
+    ConcurrentSimpleVector() noexcept = default;
+
+    // Заранее выделяет сегменты под capacity элементов
+    explicit ConcurrentSimpleVector(ReserveProxyObj obj) {
+        Reserve(obj.capacity_to_reserve_);
+    }
+
+    // Сегменты принадлежат вектору навсегда, поэтому ни копировать, ни перемещать его нельзя
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector() {
+        Clear();
+        for (size_t segment = 0; segment < kSegmentCount; ++segment) {
+            // Память возвращается в RawStorage, который её и выделил
+            RawStorage<Type> storage(segments_[segment].load(std::memory_order_relaxed), SegmentSize(segment));
+        }
+    }
+
+    // Количество зарезервированных ячеек, включая элементы, которые ещё создаются другими потоками
+    size_t GetSize() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    Type& operator[](size_t index) noexcept {
+        assert(index < GetSize());
+        const Location location = Locate(index);
+        return segments_[location.segment].load(std::memory_order_acquire)[location.offset];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        const Location location = Locate(index);
+        return segments_[location.segment].load(std::memory_order_acquire)[location.offset];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("index > size_");
+        }
+        return (*this)[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("index > size_");
+        }
+        return (*this)[index];
+    }
+
+    // Добавляет элемент и возвращает его индекс. GetSize для этого не годится: другие потоки могли уже зарезервировать следующие ячейки
+    size_t PushBack(const Type& item) {
+        return EmplaceBackIndexed(item).first;
+    }
+
+    size_t PushBack(Type&& item) {
+        return EmplaceBackIndexed(std::move(item)).first;
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *EmplaceBackIndexed(std::forward<Args>(args)...).second;
+    }
+
+    // Выделяет сегменты, нужные для хранения capacity элементов. Потокобезопасен
+    void Reserve(size_t capacity) {
+        if (capacity == 0) {
+            return;
+        }
+        const size_t last = Locate(capacity - 1).segment;
+        for (size_t segment = 0; segment <= last; ++segment) {
+            GetOrAllocateSegment(segment);
+        }
+    }
+
+    // Разрушает элементы, оставляя сегменты выделенными. Нельзя вызывать одновременно с добавлением
+    void Clear() noexcept {
+        ForEachSegment([](Type* items, size_t count) {
+            std::destroy_n(items, count);
+        });
+        size_.store(0, std::memory_order_relaxed);
+    }
+
+    // Переносит элементы в обычный SimpleVector одним проходом по сегментам, оставляя этот вектор пустым.
+    // Тривиально перемещаемые элементы переносятся memcpy по сегменту за раз
+    SimpleVector<Type> Flatten() {
+        SimpleVector<Type> result;
+        result.Reserve(GetSize());
+        result.AppendConstructed(GetSize(), [this](Type* dest) {
+            size_t done = 0;
+            if constexpr (IsTriviallyRelocatable<Type>::value) {
+                ForEachSegment([&](Type* items, size_t count) {
+                    detail::RelocateBytes(items, count, dest + done);
+                    done += count;
+                });
+                size_.store(0, std::memory_order_relaxed);
+            }
+            else {
+                // Исключение при переносе оставляет этот вектор нетронутым, перенесённые копии разрушаются
+                try {
+                    ForEachSegment([&](Type* items, size_t count) {
+                        detail::UninitializedMoveIfNoexcept(items, items + count, dest + done);
+                        done += count;
+                    });
+                }
+                catch (...) {
+                    std::destroy_n(dest, done);
+                    throw;
+                }
+            }
+        });
+        Clear();
+        return result;
+    }
+
+    // Копирует элементы в обычный SimpleVector
+    SimpleVector<Type> ToSimpleVector() const {
+        SimpleVector<Type> result;
+        result.Reserve(GetSize());
+        ForEachSegment([&result](const Type* items, size_t count) {
+            result.Append(items, items + count);
+        });
+        return result;
+    }
+
+private:
+    struct Location {
+        size_t segment;
+        size_t offset;
+    };
+
+    std::atomic<size_t> size_{ 0 };
+    std::atomic<Type*> segments_[kSegmentCount]{};
+
+    // Номер старшего установленного бита. value не должно быть нулевым
+    static size_t HighestBit(size_t value) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        return sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(value));
+#endif
+    }
+
+    static size_t SegmentSize(size_t segment) noexcept {
+        return kFirstSegmentSize << segment;
+    }
+
+    // Сегмент k начинается с индекса kFirstSegmentSize * (2^k - 1), поэтому номер сегмента —
+    // это номер старшего бита index + kFirstSegmentSize за вычетом kFirstSegmentBits
+    static Location Locate(size_t index) noexcept {
+        const size_t biased = index + kFirstSegmentSize;
+        const size_t high_bit = HighestBit(biased);
+        const size_t segment = high_bit - kFirstSegmentBits;
+        return { segment, biased - (size_t(1) << high_bit) };
+    }
+
+    // Если сегмента ещё нет, каждый поток выделяет свой и пытается опубликовать его через CAS.
+    // Проигравшие освобождают свою память и используют опубликованный сегмент, так что никто никого не ждёт
+    Type* GetOrAllocateSegment(size_t segment) {
+        Type* items = segments_[segment].load(std::memory_order_acquire);
+        if (items != nullptr) {
+            return items;
+        }
+        RawStorage<Type> storage(SegmentSize(segment));
+        Type* expected = nullptr;
+        if (segments_[segment].compare_exchange_strong(expected, storage.Get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return storage.Release();
+        }
+        return expected;
+    }
+
+    template <typename... Args>
+    std::pair<size_t, Type*> EmplaceBackIndexed(Args&&... args) {
+        const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+        const Location location = Locate(index);
+        Type* slot = nullptr;
+        try {
+            slot = GetOrAllocateSegment(location.segment) + location.offset;
+        }
+        catch (...) {
+            // Ячейка уже выдана и может оказаться не последней, поэтому вернуть её нельзя
+            std::terminate();
+        }
+        if constexpr (std::is_nothrow_constructible_v<Type, Args&&...>) {
+            new (slot) Type(std::forward<Args>(args)...);
+        }
+        else {
+            static_assert(std::is_nothrow_default_constructible_v<Type>,
+                          "ConcurrentSimpleVector needs a nothrow fallback for elements whose construction may throw");
+            try {
+                new (slot) Type(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                // Зарезервированная ячейка должна содержать живой объект: остаётся значение по умолчанию
+                new (slot) Type();
+                throw;
+            }
+        }
+        return { index, slot };
+    }
+
+    // Вызывает func(items, count) для заполненной части каждого сегмента по порядку
+    template <typename Func>
+    void ForEachSegment(Func func) const {
+        size_t remaining = size_.load(std::memory_order_acquire);
+        for (size_t segment = 0; remaining != 0; ++segment) {
+            const size_t count = std::min(remaining, SegmentSize(segment));
+            func(segments_[segment].load(std::memory_order_acquire), count);
+            remaining -= count;
+        }
+    }
+};
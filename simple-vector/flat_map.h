@@ -0,0 +1,573 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+
+// Индекс первого элемента отсортированного массива, не меньшего key. Вместо ветвления по результату сравнения
+// на каждом шаге выбирается одна из двух границ, что компилятор превращает в условную пересылку (cmov):
+// непредсказуемые переходы не сбрасывают конвейер, а число шагов зависит только от size
+template <typename Key, typename Compare>
+size_t BranchlessLowerBound(const Key* data, size_t size, const Key& key, const Compare& comp) {
+    if (size == 0) {
+        return 0;
+    }
+    const Key* base = data;
+    while (size > 1) {
+        const size_t half = size / 2;
+        base = comp(base[half - 1], key) ? base + half : base;
+        size -= half;
+    }
+    return (base - data) + static_cast<size_t>(comp(*base, key));
+}
+
+// План слияния отсортированного массива keys с отсортированным пакетом из batch_size ключей, i-й из которых — batch_key(i).
+// selected — номера ключей пакета, которые нужно добавить: без уже имеющихся и без повторов (остаётся первый из равных);
+// positions[k] — индекс имеющегося ключа, перед которым встаёт selected[k].
+// План строится одними сравнениями, ничего не перемещая, поэтому исключение из comp не затрагивает keys
+struct MergePlan {
+    SimpleVector<size_t> selected;
+    SimpleVector<size_t> positions;
+};
+
+template <typename Key, typename BatchKey, typename Compare>
+MergePlan PlanSortedMerge(const Key* keys, size_t size, size_t batch_size, BatchKey batch_key, const Compare& comp) {
+    MergePlan plan;
+    plan.selected.Reserve(batch_size);
+    plan.positions.Reserve(batch_size);
+    size_t index = 0;
+    for (size_t i = 0; i < batch_size; ++i) {
+        const Key& key = batch_key(i);
+        while (index < size && comp(keys[index], key)) {
+            ++index;
+        }
+        const bool exists = (index < size && !comp(key, keys[index]))
+                            || (!plan.selected.IsEmpty() && !comp(batch_key(plan.selected[plan.selected.GetSize() - 1]), key));
+        if (!exists) {
+            plan.selected.PushBack(i);
+            plan.positions.PushBack(index);
+        }
+    }
+    return plan;
+}
+
+} // namespace detail
+
+// FlatSet — множество уникальных ключей, хранящихся по возрастанию в одном SimpleVector.
+// Поиск — двоичный без ветвлений по непрерывной памяти, без узлов в куче и переходов по указателям, как в std::set.
+// Вставка и удаление одного ключа сдвигают хвост (SimpleVector::Insert/Erase) и стоят O(n),
+// поэтому большие наборы ключей лучше добавлять одним InsertRange.
+// Итераторы и ссылки становятся недействительными после любого изменения
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet {
+public:
+    using Iterator = typename SimpleVector<Key>::ConstIterator;
+    using ConstIterator = typename SimpleVector<Key>::ConstIterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp)
+        : comp_(comp)
+    {}
+
+    FlatSet(std::initializer_list<Key> init, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        InsertRange(init.begin(), init.end());
+    }
+
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    FlatSet(InputIt first, InputIt last, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        InsertRange(first, last);
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Ключи по возрастанию как обычный вектор только для чтения
+    const SimpleVector<Key>& Keys() const noexcept {
+        return keys_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return keys_.end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Первый ключ, не меньший key
+    ConstIterator LowerBound(const Key& key) const {
+        return begin() + detail::BranchlessLowerBound(keys_.Data(), keys_.GetSize(), key, comp_);
+    }
+
+    // Возвращает end(), если ключа нет
+    ConstIterator Find(const Key& key) const {
+        const ConstIterator it = LowerBound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != end();
+    }
+
+    // Возвращает позицию ключа и true, если он добавлен, или позицию имеющегося ключа и false
+    std::pair<ConstIterator, bool> Insert(const Key& key) {
+        const ConstIterator it = LowerBound(key);
+        if (it != end() && !comp_(key, *it)) {
+            return { it, false };
+        }
+        return { keys_.Insert(it, key), true };
+    }
+
+    std::pair<ConstIterator, bool> Insert(Key&& key) {
+        const ConstIterator it = LowerBound(key);
+        if (it != end() && !comp_(key, *it)) {
+            return { it, false };
+        }
+        return { keys_.Insert(it, std::move(key)), true };
+    }
+
+    // Добавляет ключи [first, last) за один проход: они сортируются отдельно и сливаются с имеющимися в новый массив.
+    // Из равных ключей остаётся тот, что был добавлен раньше.
+    // Если сравнение или копирование ключа выбросит исключение, множество не изменится: план слияния строится
+    // до переноса, а имеющиеся ключи перемещаются, только когда перемещение не выбрасывает исключений
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    void InsertRange(InputIt first, InputIt last) {
+        SimpleVector<Key> batch(first, last);
+        std::stable_sort(batch.begin(), batch.end(), comp_);
+        const detail::MergePlan plan = detail::PlanSortedMerge(keys_.Data(), keys_.GetSize(), batch.GetSize(),
+                                                               [&batch](size_t i) -> const Key& { return batch[i]; }, comp_);
+        if (plan.selected.IsEmpty()) {
+            return;
+        }
+        SimpleVector<Key> keys;
+        keys.Reserve(keys_.GetSize() + plan.selected.GetSize());
+        // После Reserve добавление не выделяет память, поэтому перемещение без исключений не может прерваться на полпути
+        auto take = [&keys](Key& key) {
+            if constexpr (std::is_nothrow_move_constructible_v<Key>) {
+                keys.PushBack(std::move(key));
+            }
+            else {
+                keys.PushBack(std::as_const(key));
+            }
+        };
+        size_t index = 0;
+        for (size_t k = 0; k < plan.selected.GetSize(); ++k) {
+            while (index < plan.positions[k]) {
+                take(keys_[index++]);
+            }
+            keys.PushBack(std::move(batch[plan.selected[k]]));
+        }
+        while (index < keys_.GetSize()) {
+            take(keys_[index++]);
+        }
+        keys_.swap(keys);
+    }
+
+    // Возвращает количество удалённых ключей (0 или 1)
+    size_t Erase(const Key& key) {
+        const ConstIterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        keys_.Erase(it);
+        return 1;
+    }
+
+    ConstIterator Erase(ConstIterator pos) {
+        return keys_.Erase(pos);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+    }
+
+    void swap(FlatSet& other) noexcept {
+        keys_.swap(other.keys_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    SimpleVector<Key> keys_;
+    Compare comp_{};
+};
+
+template <typename Key, typename Compare>
+bool operator==(const FlatSet<Key, Compare>& lhs, const FlatSet<Key, Compare>& rhs) {
+    return lhs.Keys() == rhs.Keys();
+}
+
+template <typename Key, typename Compare>
+bool operator!=(const FlatSet<Key, Compare>& lhs, const FlatSet<Key, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+// FlatMap — отображение, хранящее отсортированные ключи и значения в двух параллельных SimpleVector.
+// Поиск читает только массив ключей, поэтому в кэш попадают одни ключи, а значение загружается лишь для найденного.
+// Элемент представлен парой ссылок std::pair<const Key&, Value&>, что позволяет писать for (auto [key, value] : map).
+// Как и у FlatSet, одиночные вставки и удаления стоят O(n), а наборы пар лучше добавлять через InsertRange.
+// Итераторы и ссылки становятся недействительными после любой вставки или удаления
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+public:
+    template <bool IsConst>
+    class PairIterator {
+        using ValuePointer = std::conditional_t<IsConst, const Value*, Value*>;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, std::conditional_t<IsConst, const Value&, Value&>>;
+        using pointer = void;
+
+        PairIterator() noexcept = default;
+
+        // Изменяемый итератор неявно превращается в константный
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        PairIterator(const PairIterator<OtherConst>& other) noexcept
+            : keys_(other.keys_)
+            , values_(other.values_)
+            , index_(other.index_)
+        {}
+
+        reference operator*() const noexcept {
+            return reference(keys_[index_], values_[index_]);
+        }
+
+        PairIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        PairIterator operator++(int) noexcept {
+            PairIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        PairIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        PairIterator operator--(int) noexcept {
+            PairIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        friend bool operator==(const PairIterator& lhs, const PairIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const PairIterator& lhs, const PairIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+    private:
+        friend class FlatMap;
+
+        template <bool>
+        friend class PairIterator;
+
+        PairIterator(const Key* keys, ValuePointer values, size_t index) noexcept
+            : keys_(keys)
+            , values_(values)
+            , index_(index)
+        {}
+
+        const Key* keys_ = nullptr;
+        ValuePointer values_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using Iterator = PairIterator<false>;
+    using ConstIterator = PairIterator<true>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp)
+        : comp_(comp)
+    {}
+
+    FlatMap(std::initializer_list<std::pair<Key, Value>> init, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        InsertRange(init.begin(), init.end());
+    }
+
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    FlatMap(InputIt first, InputIt last, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        InsertRange(first, last);
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Ключи по возрастанию и значения в том же порядке
+    const SimpleVector<Key>& Keys() const noexcept {
+        return keys_;
+    }
+
+    const SimpleVector<Value>& Values() const noexcept {
+        return values_;
+    }
+
+    Iterator begin() noexcept {
+        return MakeIterator(0);
+    }
+
+    Iterator end() noexcept {
+        return MakeIterator(GetSize());
+    }
+
+    ConstIterator begin() const noexcept {
+        return MakeIterator(0);
+    }
+
+    ConstIterator end() const noexcept {
+        return MakeIterator(GetSize());
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Возвращает end(), если ключа нет
+    Iterator Find(const Key& key) {
+        return MakeIterator(FindIndex(key));
+    }
+
+    ConstIterator Find(const Key& key) const {
+        return MakeIterator(FindIndex(key));
+    }
+
+    bool Contains(const Key& key) const {
+        return FindIndex(key) != GetSize();
+    }
+
+    // Выбрасывает исключение std::out_of_range, если ключа нет
+    Value& At(const Key& key) {
+        const size_t index = FindIndex(key);
+        if (index == GetSize()) {
+            throw std::out_of_range("key not found");
+        }
+        return values_[index];
+    }
+
+    const Value& At(const Key& key) const {
+        const size_t index = FindIndex(key);
+        if (index == GetSize()) {
+            throw std::out_of_range("key not found");
+        }
+        return values_[index];
+    }
+
+    // Возвращает значение по ключу, добавляя значение по умолчанию, если ключа нет
+    Value& operator[](const Key& key) {
+        return (*TryEmplace(key).first).second;
+    }
+
+    // Добавляет пару, если ключа ещё нет. Возвращает позицию элемента и признак вставки
+    std::pair<Iterator, bool> Insert(const Key& key, const Value& value) {
+        return TryEmplace(key, value);
+    }
+
+    std::pair<Iterator, bool> Insert(Key&& key, Value&& value) {
+        return TryEmplace(std::move(key), std::move(value));
+    }
+
+    // Добавляет пару или заменяет значение имеющегося ключа
+    template <typename V>
+    std::pair<Iterator, bool> InsertOrAssign(const Key& key, V&& value) {
+        auto [it, inserted] = TryEmplace(key, std::forward<V>(value));
+        if (!inserted) {
+            (*it).second = std::forward<V>(value);
+        }
+        return { it, inserted };
+    }
+
+    // Если ключа нет, создаёт значение из args. Иначе args не используются
+    template <typename... Args>
+    std::pair<Iterator, bool> TryEmplace(const Key& key, Args&&... args) {
+        return TryEmplaceImpl(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<Iterator, bool> TryEmplace(Key&& key, Args&&... args) {
+        return TryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // Добавляет пары [first, last) за один проход: пары сортируются по ключу и сливаются с имеющимися
+    // в новые массивы ключей и значений. Из пар с равными ключами остаётся добавленная раньше.
+    // Если при слиянии выброшено исключение, отображение не изменяется: план слияния строится одними сравнениями
+    // до переноса, а имеющиеся элементы переносятся в новые массивы перемещением, только когда ключи и значения
+    // перемещаются без исключений, и копируются иначе
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    void InsertRange(InputIt first, InputIt last) {
+        SimpleVector<std::pair<Key, Value>> batch(first, last);
+        std::stable_sort(batch.begin(), batch.end(), [this](const auto& lhs, const auto& rhs) {
+            return comp_(lhs.first, rhs.first);
+        });
+        const detail::MergePlan plan = detail::PlanSortedMerge(keys_.Data(), keys_.GetSize(), batch.GetSize(),
+                                                               [&batch](size_t i) -> const Key& { return batch[i].first; }, comp_);
+        if (plan.selected.IsEmpty()) {
+            return;
+        }
+        SimpleVector<Key> keys;
+        SimpleVector<Value> values;
+        keys.Reserve(keys_.GetSize() + plan.selected.GetSize());
+        values.Reserve(values_.GetSize() + plan.selected.GetSize());
+        // После Reserve добавление не выделяет память, поэтому перемещение без исключений не может прерваться на полпути
+        auto take_existing = [&](size_t index) {
+            if constexpr (std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<Value>) {
+                keys.PushBack(std::move(keys_[index]));
+                values.PushBack(std::move(values_[index]));
+            }
+            else {
+                keys.PushBack(keys_[index]);
+                values.PushBack(values_[index]);
+            }
+        };
+        size_t index = 0;
+        for (size_t k = 0; k < plan.selected.GetSize(); ++k) {
+            while (index < plan.positions[k]) {
+                take_existing(index++);
+            }
+            auto& [key, value] = batch[plan.selected[k]];
+            keys.PushBack(std::move(key));
+            values.PushBack(std::move(value));
+        }
+        while (index < keys_.GetSize()) {
+            take_existing(index++);
+        }
+        keys_.swap(keys);
+        values_.swap(values);
+    }
+
+    // Возвращает количество удалённых элементов (0 или 1)
+    size_t Erase(const Key& key) {
+        const size_t index = FindIndex(key);
+        if (index == GetSize()) {
+            return 0;
+        }
+        EraseAt(index);
+        return 1;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        assert(pos.index_ < GetSize());
+        EraseAt(pos.index_);
+        return MakeIterator(pos.index_);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+        values_.Reserve(capacity);
+    }
+
+    void swap(FlatMap& other) noexcept {
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    SimpleVector<Key> keys_;
+    SimpleVector<Value> values_;
+    Compare comp_{};
+
+    Iterator MakeIterator(size_t index) noexcept {
+        return Iterator(keys_.Data(), values_.Data(), index);
+    }
+
+    ConstIterator MakeIterator(size_t index) const noexcept {
+        return ConstIterator(keys_.Data(), values_.Data(), index);
+    }
+
+    // Возвращает GetSize(), если ключа нет
+    size_t FindIndex(const Key& key) const {
+        const size_t index = detail::BranchlessLowerBound(keys_.Data(), keys_.GetSize(), key, comp_);
+        return index != GetSize() && !comp_(key, keys_[index]) ? index : GetSize();
+    }
+
+    template <typename K, typename... Args>
+    std::pair<Iterator, bool> TryEmplaceImpl(K&& key, Args&&... args) {
+        const size_t index = detail::BranchlessLowerBound(keys_.Data(), keys_.GetSize(), key, comp_);
+        if (index != GetSize() && !comp_(key, keys_[index])) {
+            return { MakeIterator(index), false };
+        }
+        values_.Emplace(values_.begin() + index, std::forward<Args>(args)...);
+        try {
+            keys_.Emplace(keys_.begin() + index, std::forward<K>(key));
+        }
+        catch (...) {
+            values_.Erase(values_.begin() + index);
+            throw;
+        }
+        return { MakeIterator(index), true };
+    }
+
+    void EraseAt(size_t index) {
+        keys_.Erase(keys_.begin() + index);
+        values_.Erase(values_.begin() + index);
+    }
+};
+
+template <typename Key, typename Value, typename Compare>
+bool operator==(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return lhs.Keys() == rhs.Keys() && lhs.Values() == rhs.Values();
+}
+
+template <typename Key, typename Value, typename Compare>
+bool operator!=(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return !(lhs == rhs);
+}
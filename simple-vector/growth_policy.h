@@ -0,0 +1,75 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+// Политики роста вместимости для SimpleVector и родственных контейнеров.
+// Политика — это тип со статическим методом
+//     static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+// который по текущей вместимости, требуемому количеству элементов и размеру элемента в байтах
+// возвращает новую вместимость в элементах. Результат должен быть не меньше required
+
+// Рост вдвое. Быстрее всего наращивает вместимость, но может оставлять неиспользованной до половины памяти
+struct DoublingGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(required, capacity * 2);
+    }
+};
+
+// Рост в полтора раза. Вдвое меньше запас памяти ценой более частых перевыделений
+struct OneAndHalfGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(required, capacity + capacity / 2);
+    }
+};
+
+// Рост в 1.6 раза — чуть меньше золотого сечения. При таком множителе сумма освобождённых ранее блоков
+// со временем становится достаточной для следующего, и аллокатор может переиспользовать эту память
+struct GoldenRatioGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(required, capacity + capacity * 3 / 5);
+    }
+};
+
+// Округляет вместимость базовой политики вверх до целого числа страниц PageSize,
+// чтобы хвост последней страницы большого буфера не пропадал зря. Маленькие буферы не округляются
+template <typename BasePolicy = DoublingGrowth, size_t PageSize = 4096>
+struct PageRoundedGrowth {
+    static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t base = BasePolicy::NextCapacity(capacity, required, element_size);
+        const size_t bytes = base * element_size;
+        if (bytes < PageSize) {
+            return base;
+        }
+        const size_t rounded = (bytes + PageSize - 1) & ~(PageSize - 1);
+        return std::max(base, rounded / element_size);
+    }
+};
+
+// Округляет вместимость базовой политики вверх до размерного класса аллокатора (jemalloc, tcmalloc, mimalloc).
+// Такие аллокаторы всё равно выдают блок размера класса, поэтому остаток блока используется под элементы.
+// Классы устроены как в jemalloc: 8, кратные 16 до 128, а дальше по четыре класса на каждую степень двойки (2^k * 1.25, 1.5, 1.75, 2)
+template <typename BasePolicy = DoublingGrowth>
+struct SizeClassGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t base = BasePolicy::NextCapacity(capacity, required, element_size);
+        return std::max(base, RoundToSizeClass(base * element_size) / element_size);
+    }
+
+    static size_t RoundToSizeClass(size_t bytes) noexcept {
+        if (bytes <= 8) {
+            return 8;
+        }
+        if (bytes <= 128) {
+            return (bytes + 15) / 16 * 16;
+        }
+        // Шаг между классами — четверть наибольшей степени двойки, меньшей bytes
+        size_t power = 128;
+        while (power * 2 < bytes) {
+            power *= 2;
+        }
+        const size_t step = power / 4;
+        return (bytes + step - 1) / step * step;
+    }
+};
@@ -1,9 +1,40 @@
+#include "aligned_allocator.h"
+#include "batch_exchange.h"
+#include "concurrent_simple_vector.h"
+#include "flat_map.h"
+#include "mmap_simple_vector.h"
+#include "segmented_simple_vector.h"
+#include "shared_simple_vector.h"
 #include "simple_vector.h"
+#include "simple_vector_io.h"
+#include "simple_vector_parallel.h"
+#include "simple_vector_view.h"
+#include "small_simple_vector.h"
+#include "soa_simple_vector.h"
+#include "static_simple_vector.h"
 
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#if defined(SIMPLE_VECTOR_ANNOTATE_CONTAINER)
+#include <sanitizer/asan_interface.h>
+#endif
 
 using namespace std;
 
@@ -32,6 +63,68 @@ private:
     size_t x_;
 };
 
+// Считает вызовы конструкторов и деструкторов, чтобы проверять, какие ячейки вектор реально создаёт
+struct Counted {
+    static inline size_t constructed = 0;
+    static inline size_t destroyed = 0;
+
+    static void ResetCounters() {
+        constructed = 0;
+        destroyed = 0;
+    }
+
+    Counted() {
+        ++constructed;
+    }
+    Counted(const Counted&) {
+        ++constructed;
+    }
+    Counted(Counted&&) noexcept {
+        ++constructed;
+    }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() {
+        ++destroyed;
+    }
+};
+
+// Владеет указателем на кучу: не тривиально копируем, но его можно переносить побайтово
+struct Boxed {
+    unique_ptr<size_t> value;
+};
+
+template <>
+struct IsTriviallyRelocatable<Boxed> : std::true_type {};
+
+// Перемещение не помечено noexcept, а копирование выбрасывает исключение после заданного числа успешных копий
+struct ThrowingCopy {
+    static inline size_t copies = 0;
+    static inline size_t moves = 0;
+    static inline size_t copies_before_throw = SIZE_MAX;
+
+    explicit ThrowingCopy(int value = 0)
+        : value(value) {
+    }
+    ThrowingCopy(const ThrowingCopy& other)
+        : value(other.value) {
+        if (copies_before_throw == 0) {
+            throw runtime_error("copy failed");
+        }
+        --copies_before_throw;
+        ++copies;
+    }
+    ThrowingCopy(ThrowingCopy&& other)
+        : value(other.value) {
+        other.value = -1;
+        ++moves;
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    ThrowingCopy& operator=(ThrowingCopy&&) = default;
+
+    int value;
+};
+
 SimpleVector<int> GenerateVector(size_t size) {
     SimpleVector<int> v(size);
     iota(v.begin(), v.end(), 1);
@@ -62,9 +155,15 @@ void TestNamedMoveConstructor() {
     SimpleVector<int> vector_to_move(GenerateVector(size));
     assert(vector_to_move.GetSize() == size);
 
+    const int* data = vector_to_move.Data();
     SimpleVector<int> moved_vector(move(vector_to_move));
     assert(moved_vector.GetSize() == size);
     assert(vector_to_move.GetSize() == 0);
+    // Память забирается без выделения новой
+    assert(moved_vector.Data() == data);
+    assert(vector_to_move.GetCapacity() == 0);
+    static_assert(is_nothrow_move_constructible_v<SimpleVector<int>>);
+    static_assert(is_nothrow_move_constructible_v<SimpleVector<X>>);
     cout << "Done!"s << endl << endl;
 }
 
@@ -150,6 +249,1526 @@ void TestNoncopiableErase() {
     cout << "Done!"s << endl << endl;
 }
 
+void TestUninitializedCapacity() {
+    cout << "Test capacity is not constructed"s << endl;
+    Counted::ResetCounters();
+    {
+        SimpleVector<Counted> v;
+        v.Reserve(100);
+        assert(v.GetCapacity() == 100);
+        assert(Counted::constructed == 0);
+
+        v.Resize(10);
+        assert(Counted::constructed == 10);
+
+        v.PushBack(Counted());
+        // временный объект + элемент в векторе
+        assert(Counted::constructed == 12);
+
+        v.PopBack();
+        v.Resize(5);
+        assert(Counted::constructed - Counted::destroyed == 5);
+    }
+    assert(Counted::constructed == Counted::destroyed);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestEmplace() {
+    cout << "Test emplace"s << endl;
+    SimpleVector<pair<string, size_t>> v;
+    auto& first = v.EmplaceBack("b"s, 2);
+    assert(first.first == "b"s && first.second == 2);
+    for (size_t i = 0; i < 10; ++i) {
+        v.EmplaceBack(to_string(i), i);
+    }
+    assert(v.GetSize() == 11);
+    assert(v.GetCapacity() == 16);
+
+    auto it = v.Emplace(v.begin(), "a"s, 1);
+    assert(it == v.begin());
+    assert(v[0].first == "a"s && v[1].first == "b"s);
+
+    it = v.Emplace(v.begin() + 5, v[0]);
+    assert(it->first == "a"s && v.GetSize() == 13);
+
+    SimpleVector<X> x;
+    x.EmplaceBack(7);
+    x.Emplace(x.begin(), 3);
+    assert(x[0].GetX() == 3 && x[1].GetX() == 7);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestTriviallyRelocatable() {
+    cout << "Test trivially relocatable growth"s << endl;
+    SimpleVector<int> ints;
+    for (int i = 0; i < 1000; ++i) {
+        ints.PushBack(i);
+    }
+    ints.Insert(ints.begin(), -1);
+    ints.Insert(ints.begin() + 500, ints[0]);
+    ints.Erase(ints.begin() + 1);
+    assert(ints.GetSize() == 1001);
+    assert(ints[0] == -1 && ints[1] == 1 && ints[498] == 498 && ints[499] == -1 && ints[500] == 499 && ints[1000] == 999);
+
+    SimpleVector<Boxed> boxes;
+    for (size_t i = 0; i < 100; ++i) {
+        boxes.PushBack(Boxed{ make_unique<size_t>(i) });
+    }
+    boxes.Insert(boxes.begin() + 50, Boxed{ make_unique<size_t>(1000) });
+    boxes.Erase(boxes.begin());
+    assert(boxes.GetSize() == 100);
+    assert(*boxes[0].value == 1 && *boxes[49].value == 1000 && *boxes[99].value == 99);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAllocator() {
+    cout << "Test allocator"s << endl;
+    array<std::byte, 4096> arena;
+    pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), pmr::null_memory_resource());
+    {
+        SimpleVector<int, pmr::polymorphic_allocator<int>> v(&resource);
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        v.Insert(v.begin(), -1);
+        assert(v.GetSize() == 101 && v[0] == -1 && v[100] == 99);
+        assert(v.GetAllocator().resource() == &resource);
+
+        SimpleVector<int, pmr::polymorphic_allocator<int>> copy(v, &resource);
+        assert(copy == v);
+
+        // Память другого ресурса забрать нельзя: элементы переносятся в память copy
+        SimpleVector<int, pmr::polymorphic_allocator<int>> other(10, 7);
+        copy = move(other);
+        assert(copy.GetSize() == 10 && copy[9] == 7);
+        assert(copy.GetAllocator().resource() == &resource);
+    }
+
+    SimpleVector<string, pmr::polymorphic_allocator<string>> strings(&resource);
+    strings.PushBack("long enough string to leave the small buffer"s);
+    strings.EmplaceBack(10, 'x');
+    assert(strings.GetSize() == 2 && strings[1] == "xxxxxxxxxx"s);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSmallSimpleVector() {
+    cout << "Test small simple vector"s << endl;
+    SmallSimpleVector<string, 4> v;
+    assert(v.IsInline() && v.GetCapacity() == 4);
+    for (size_t i = 0; i < 4; ++i) {
+        v.PushBack(to_string(i));
+    }
+    assert(v.IsInline());
+
+    // Копия и перемещение встроенного буфера
+    SmallSimpleVector<string, 4> copy(v);
+    SmallSimpleVector<string, 4> moved(move(copy));
+    assert(moved == v && copy.IsEmpty() && moved.IsInline());
+
+    v.Insert(v.begin(), "x"s);
+    assert(!v.IsInline() && v.GetCapacity() == 8);
+    assert(v.GetSize() == 5 && v[0] == "x"s && v[4] == "3"s);
+    assert(moved < v);
+
+    moved.swap(v);
+    assert(moved.GetSize() == 5 && v.GetSize() == 4);
+    v = moved;
+    assert(v == moved);
+
+    v.Erase(v.begin());
+    v.PopBack();
+    assert(v.GetSize() == 3 && v[2] == "2"s);
+
+    SmallSimpleVector<X, 2> x;
+    for (size_t i = 0; i < 5; ++i) {
+        x.EmplaceBack(i);
+    }
+    SmallSimpleVector<X, 2> x_moved = move(x);
+    assert(x_moved.GetSize() == 5 && x_moved[4].GetX() == 4);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestGrowthPolicy() {
+    cout << "Test growth policy"s << endl;
+    SimpleVector<int, allocator<int>, OneAndHalfGrowth> v;
+    for (int i = 0; i < 10; ++i) {
+        v.PushBack(i);
+    }
+    // 1 -> 2 -> 3 -> 4 -> 6 -> 9 -> 13
+    assert(v.GetCapacity() == 13);
+
+    SimpleVector<int, allocator<int>, GoldenRatioGrowth> golden(10);
+    golden.PushBack(10);
+    assert(golden.GetCapacity() == 16);
+
+    // 2000 * 4 байта округляются до двух страниц
+    SimpleVector<int, allocator<int>, PageRoundedGrowth<>> paged(1000);
+    paged.PushBack(0);
+    assert(paged.GetCapacity() == 2048);
+
+    assert(SizeClassGrowth<>::RoundToSizeClass(100) == 112);
+    assert(SizeClassGrowth<>::RoundToSizeClass(129) == 160);
+    assert(SizeClassGrowth<>::RoundToSizeClass(4097) == 5120);
+    SimpleVector<char, allocator<char>, SizeClassGrowth<>> chars(100);
+    chars.PushBack('x');
+    assert(chars.GetCapacity() == 224);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestRangeOperations() {
+    cout << "Test range operations"s << endl;
+    const list<string> words = { "a"s, "b"s, "c"s };
+    SimpleVector<string> v(words.begin(), words.end());
+    assert(v.GetSize() == 3 && v.GetCapacity() == 3 && v[2] == "c"s);
+
+    // Один раз перевыделяется, даже если диапазон — сам вектор
+    v.Append(v.begin(), v.end());
+    assert(v.GetSize() == 6 && v[3] == "a"s && v[5] == "c"s);
+
+    const string more[] = { "x"s, "y"s };
+    auto it = v.InsertRange(v.begin() + 1, begin(more), end(more));
+    assert(it == v.begin() + 1);
+    assert(v.GetSize() == 8 && v[0] == "a"s && v[1] == "x"s && v[2] == "y"s && v[3] == "b"s && v[7] == "c"s);
+
+    v.InsertRange(v.end(), begin(more), end(more));
+    assert(v.GetSize() == 10 && v[9] == "y"s);
+
+    v.Assign(words.begin(), words.end());
+    assert(v.GetSize() == 3 && v[0] == "a"s);
+
+    // Однопроходный итератор
+    istringstream input("1 2 3 4"s);
+    SimpleVector<int> ints{ istream_iterator<int>(input), istream_iterator<int>() };
+    assert(ints.GetSize() == 4 && ints[3] == 4);
+    ints.InsertRange(ints.begin(), ints.begin() + 2, ints.end());
+    assert((ints == SimpleVector<int>{ 3, 4, 1, 2, 3, 4 }));
+
+    // (size, value) не путается с диапазоном
+    SimpleVector<size_t> sizes(3, 7);
+    assert(sizes.GetSize() == 3 && sizes[2] == 7);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestArithmeticComparisons() {
+    cout << "Test arithmetic comparisons"s << endl;
+    SimpleVector<uint8_t> bytes(100, 7);
+    SimpleVector<uint8_t> other_bytes(bytes);
+    assert(bytes == other_bytes && !(bytes < other_bytes));
+    other_bytes[99] = 200;
+    assert(bytes != other_bytes && bytes < other_bytes);
+    other_bytes.PopBack();
+    assert(other_bytes < bytes);
+
+    SimpleVector<int32_t> ints(1000, 5);
+    SimpleVector<int32_t> other_ints(ints);
+    assert(ints == other_ints && ints <= other_ints);
+    // Отрицательное число меньше, хотя его старший байт больше
+    other_ints[700] = -1;
+    assert(other_ints < ints && ints > other_ints);
+    other_ints[700] = 0x100;
+    assert(ints < other_ints);
+
+    // 0.0 == -0.0 при разных байтах, NaN несравнимо, но не прерывает сравнение
+    SimpleVector<float> floats{ 0.0f, NAN, 1.0f, 2.0f };
+    SimpleVector<float> other_floats{ -0.0f, NAN, 1.0f, 3.0f };
+    assert(floats < other_floats);
+    const SimpleVector<float> floats_copy(floats);
+    assert(floats != floats_copy && !(floats < floats_copy));
+    cout << "Done!"s << endl << endl;
+}
+
+void TestParallelAlgorithms() {
+    cout << "Test parallel algorithms"s << endl;
+    ThreadPool pool(4);
+    const size_t size = 200'003;
+
+    // Границы кусков, кроме первой, выровнены на кэш-линию
+    SimpleVector<double> values = MakeParallelFilled(size, 1.5, pool);
+    assert(values.GetSize() == size && values.GetCapacity() == size);
+    assert(all_of(values.begin(), values.end(), [](double x) { return x == 1.5; }));
+    const detail::ChunkPlan plan = detail::MakeChunkPlan(values.Data() + 1, size - 1, pool);
+    assert(plan.GetCount() > 1 && plan.End(plan.GetCount() - 1) == size - 1);
+    for (size_t chunk = 1; chunk < plan.GetCount(); ++chunk) {
+        assert(reinterpret_cast<uintptr_t>(values.Data() + 1 + plan.Begin(chunk)) % detail::kCacheLineSize == 0);
+    }
+
+    ParallelFill(values, 2.0, pool);
+    ParallelTransform(values, [](double x) { return x * 3; }, pool);
+    assert(ParallelReduce(values, 0.0, plus<>(), pool) == 6.0 * size);
+
+    SimpleVector<int> numbers(size);
+    uint32_t state = 12345;
+    for (auto& number : numbers) {
+        state = state * 1664525 + 1013904223;
+        number = static_cast<int>(state >> 8);
+    }
+    SimpleVector<int> copy = ParallelCopy(numbers, pool);
+    assert(copy == numbers);
+    ParallelSort(numbers, less<>(), pool);
+    sort(copy.begin(), copy.end());
+    assert(copy == numbers);
+    ParallelSort(numbers, greater<>(), pool);
+    assert(is_sorted(numbers.begin(), numbers.end(), greater<>()));
+    assert(ParallelReduce(numbers.begin(), numbers.begin(), 7, plus<>(), pool) == 7);
+
+    // Исключение из операции пробрасывается в вызывающий поток
+    SimpleVector<string> words(size, "parallel copy of a long string"s);
+    words[size - 1] = "throw"s;
+    SimpleVector<int> lengths(size);
+    try {
+        ParallelTransform(words.begin(), words.end(), lengths.begin(), [](const string& word) {
+            if (word == "throw"s) {
+                throw runtime_error("bad word");
+            }
+            return static_cast<int>(word.size());
+        }, pool);
+        assert(false);
+    }
+    catch (const runtime_error&) {
+    }
+    SimpleVector<string> words_copy = ParallelCopy(words, pool);
+    assert(words_copy == words);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestConcurrentSimpleVector() {
+    cout << "Test concurrent simple vector"s << endl;
+    const size_t threads = 4;
+    const size_t per_thread = 50'000;
+    {
+        ConcurrentSimpleVector<size_t> v;
+        assert(v.IsEmpty());
+        const size_t first_index = v.PushBack(7);
+        assert(first_index == 0);
+        const size_t* first = &v[0];
+
+        SimpleVector<thread> producers;
+        for (size_t t = 0; t < threads; ++t) {
+            producers.EmplaceBack([&v, t] {
+                for (size_t i = 0; i < per_thread; ++i) {
+                    v.PushBack(t * per_thread + i + 1);
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        // Сегменты не переезжают, поэтому ссылка на первый элемент всё ещё действительна
+        assert(&v[0] == first && *first == 7);
+        assert(v.GetSize() == threads * per_thread + 1);
+
+        SimpleVector<size_t> copy = v.ToSimpleVector();
+        assert(copy.GetSize() == v.GetSize() && copy[0] == 7);
+        SimpleVector<size_t> flat = v.Flatten();
+        assert(v.IsEmpty() && flat == copy);
+        sort(flat.begin(), flat.end());
+        // Каждое значение от 1 до threads * per_thread добавлено ровно один раз, 7 — дважды
+        for (size_t i = 0; i < flat.GetSize(); ++i) {
+            assert(flat[i] == (i < 7 ? i + 1 : i));
+        }
+        try {
+            v.At(0);
+            assert(false);
+        }
+        catch (const out_of_range&) {
+        }
+    }
+    {
+        ConcurrentSimpleVector<string> v(Reserve(100));
+        SimpleVector<thread> producers;
+        for (size_t t = 0; t < threads; ++t) {
+            producers.EmplaceBack([&v] {
+                for (size_t i = 0; i < 1000; ++i) {
+                    v.EmplaceBack(100, 'x');
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        SimpleVector<string> flat = v.Flatten();
+        assert(flat.GetSize() == threads * 1000);
+        assert(all_of(flat.begin(), flat.end(), [](const string& s) { return s.size() == 100; }));
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestMmapSimpleVector() {
+    cout << "Test mmap simple vector"s << endl;
+    struct Record {
+        uint64_t id;
+        double value;
+    };
+    const string path = "/tmp/simple_vector_mmap_test.bin"s;
+    std::remove(path.c_str());
+    const size_t size = 100'000;
+    {
+        MmapSimpleVector<Record> v(path);
+        assert(v.IsEmpty() && v.GetCapacity() > 0);
+        for (size_t i = 0; i < size; ++i) {
+            v.PushBack({ i, i * 0.5 });
+        }
+        // Аргумент ссылается на элемент самого вектора, а добавление перевыделяет отображение
+        v.Resize(v.GetCapacity());
+        v.EmplaceBack(v[1]);
+        assert(v[v.GetSize() - 1].id == 1);
+        v.Resize(size);
+        v.Advise(MmapAdvice::kSequential);
+        v.Flush();
+    }
+    {
+        // После повторного открытия вектор в том же состоянии
+        MmapSimpleVector<Record> v(path);
+        assert(v.GetSize() == size);
+        v.Advise(MmapAdvice::kRandom);
+        for (size_t i = 0; i < size; ++i) {
+            assert(v[i].id == i && v[i].value == i * 0.5);
+        }
+        MmapSimpleVector<Record> moved(std::move(v));
+        assert(v.GetSize() == 0 && moved.GetSize() == size);
+        // Перемещённый вектор пуст и не связан с файлом
+        v.Clear();
+        v.PopBack();
+        v.Flush();
+        assert(v.IsEmpty() && v.GetCapacity() == 0 && v.begin() == v.end());
+        try {
+            v.PushBack(Record{});
+            assert(false);
+        }
+        catch (const logic_error&) {
+        }
+        try {
+            v.Reserve(1);
+            assert(false);
+        }
+        catch (const logic_error&) {
+        }
+        moved.PopBack();
+        assert(moved.At(size - 2).id == size - 2);
+    }
+    {
+        MmapSimpleVector<Record> v(path);
+        assert(v.GetSize() == size - 1);
+        v.Clear();
+    }
+    try {
+        // Размер элемента не совпадает
+        MmapSimpleVector<char> wrong(path);
+        assert(false);
+    }
+    catch (const runtime_error&) {
+    }
+    std::remove(path.c_str());
+    try {
+        MmapSimpleVector<int> missing("/nonexistent-directory/file.bin"s);
+        assert(false);
+    }
+    catch (const system_error& e) {
+        assert(e.code() == errc::no_such_file_or_directory);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSerialization() {
+    cout << "Test serialization"s << endl;
+    SimpleVector<double> source(1000);
+    iota(source.begin(), source.end(), 0.25);
+    {
+        stringstream stream;
+        SaveTo(stream, source);
+        assert(stream.str().size() == GetSerializedSize(source));
+        SimpleVector<double> loaded{ 1.0, 2.0 };
+        LoadFrom(stream, loaded);
+        assert(loaded == source);
+        assert(loaded.GetCapacity() == source.GetSize());
+
+        // Повреждённые данные не проходят проверку контрольной суммы
+        string corrupted = stream.str();
+        corrupted.back() ^= 1;
+        stringstream bad_stream(corrupted);
+        try {
+            LoadFrom(bad_stream, loaded);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+            assert(loaded == source);
+        }
+
+        // Усечённый поток не меняет вектор
+        stringstream truncated_stream(stream.str().substr(0, stream.str().size() - 1));
+        try {
+            LoadFrom(truncated_stream, loaded);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+            assert(loaded == source);
+        }
+
+        // Поддельный размер в заголовке не приводит к огромному выделению памяти
+        string forged = stream.str().substr(0, 64);
+        const uint64_t forged_size = uint64_t(1) << 40;
+        memcpy(forged.data() + 16, &forged_size, sizeof(forged_size));
+        stringstream forged_stream(forged);
+        try {
+            LoadFrom(forged_stream, loaded);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+            assert(loaded == source);
+        }
+
+        // Тип элемента записан в заголовке
+        stringstream typed_stream(stream.str());
+        SimpleVector<int64_t> wrong_type{ 1 };
+        try {
+            LoadFrom(typed_stream, wrong_type);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+            assert(wrong_type.GetSize() == 1);
+        }
+    }
+    {
+        SimpleVector<unsigned char> buffer(GetSerializedSize(source));
+        assert(SaveTo(buffer.Data(), buffer.GetSize(), source) == buffer.GetSize());
+        SimpleVector<double> loaded;
+        assert(LoadFrom(buffer.Data(), buffer.GetSize(), loaded) == buffer.GetSize());
+        assert(loaded == source);
+        try {
+            LoadFrom(buffer.Data(), buffer.GetSize() - 1, loaded);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+            assert(loaded == source);
+        }
+        // Нехватка памяти при загрузке тоже не меняет вектор
+        array<std::byte, 64> arena;
+        pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), pmr::null_memory_resource());
+        SimpleVector<double, pmr::polymorphic_allocator<double>> small(&resource);
+        small.PushBack(1.0);
+        small.PushBack(2.0);
+        small.PushBack(3.0);
+        try {
+            LoadFrom(buffer.Data(), buffer.GetSize(), small);
+            assert(false);
+        }
+        catch (const bad_alloc&) {
+            assert(small.GetSize() == 3 && small[0] == 1.0 && small[2] == 3.0);
+        }
+        stringstream small_stream(string(reinterpret_cast<const char*>(buffer.Data()), buffer.GetSize()));
+        try {
+            LoadFrom(small_stream, small);
+            assert(false);
+        }
+        catch (const bad_alloc&) {
+            assert(small.GetSize() == 3 && small[0] == 1.0 && small[2] == 3.0);
+        }
+
+        // Файлы первой версии формата с сигнатурой "SVEC" не читаются
+        SimpleVector<unsigned char> old_format = buffer;
+        const uint32_t old_magic = 0x43455653;
+        memcpy(old_format.Data(), &old_magic, sizeof(old_magic));
+        try {
+            LoadFrom(old_format.Data(), old_format.GetSize(), loaded);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+            assert(loaded == source);
+        }
+        try {
+            SaveTo(buffer.Data(), buffer.GetSize() - 1, source);
+            assert(false);
+        }
+        catch (const length_error&) {
+        }
+
+        SimpleVector<double> empty;
+        SimpleVector<unsigned char> empty_buffer(GetSerializedSize(empty));
+        SaveTo(empty_buffer.Data(), empty_buffer.GetSize(), empty);
+        assert(LoadFrom(empty_buffer.Data(), empty_buffer.GetSize(), loaded) == empty_buffer.GetSize());
+        assert(loaded.IsEmpty());
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestShrinkToFit() {
+    cout << "Test shrink to fit"s << endl;
+    Counted::ResetCounters();
+    {
+        SimpleVector<Counted> v(100);
+        v.Erase(v.begin() + 10);
+        v.PopBack();
+        assert(Counted::constructed - Counted::destroyed == 98);
+        v.Resize(40);
+        v.ShrinkToFit();
+        assert(v.GetSize() == 40 && v.GetCapacity() == 40);
+        assert(Counted::constructed - Counted::destroyed == 40);
+        v.Clear();
+        assert(Counted::constructed == Counted::destroyed);
+        assert(v.GetCapacity() == 40);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 0 && v.Data() == nullptr);
+    }
+    {
+        // Тривиально перемещаемые элементы ужимаются через realloc
+        SimpleVector<Boxed> v;
+        for (size_t i = 0; i < 100; ++i) {
+            v.PushBack(Boxed{ make_unique<size_t>(i) });
+        }
+        v.Resize(3);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 3 && *v[2].value == 2);
+
+        v.Reset();
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        v.PushBack(Boxed{ make_unique<size_t>(7) });
+        assert(*v[0].value == 7);
+    }
+    {
+        SmallSimpleVector<string, 4> v;
+        for (size_t i = 0; i < 10; ++i) {
+            v.PushBack(to_string(i) + " long enough to live on the heap"s);
+        }
+        v.Resize(6);
+        v.ShrinkToFit();
+        assert(!v.IsInline() && v.GetCapacity() == 6);
+        v.Resize(2);
+        v.ShrinkToFit();
+        assert(v.IsInline() && v.GetCapacity() == 4);
+        assert(v[1] == "1 long enough to live on the heap"s);
+        v.PushBack("x"s);
+        v.Reset();
+        assert(v.IsEmpty() && v.IsInline());
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSharedSimpleVector() {
+    cout << "Test shared simple vector"s << endl;
+    SharedSimpleVector<string> empty;
+    assert(empty.IsEmpty() && !empty.IsShared() && empty.begin() == empty.end());
+
+    SharedSimpleVector<string> table{ "a"s, "b"s, "c"s };
+    const string* items = &as_const(table)[0];
+    SharedSimpleVector<string> snapshot = table;
+    // Копия разделяет элементы
+    assert(table.IsShared() && snapshot.IsShared());
+    assert(&as_const(snapshot)[0] == items && snapshot == table);
+
+    // Запись отделяет изменяемую копию, снимок остаётся прежним
+    table[0] = "z"s;
+    assert(!table.IsShared() && !snapshot.IsShared());
+    assert(as_const(snapshot)[0] == "a"s && as_const(table)[0] == "z"s);
+    assert(&as_const(snapshot)[0] == items);
+
+    SharedSimpleVector<string> second = snapshot;
+    auto it = second.Insert(second.cbegin() + 1, "x"s);
+    assert(*it == "x"s && second.GetSize() == 4 && snapshot.GetSize() == 3);
+    second.Erase(second.cbegin());
+    assert(second.Get() == SimpleVector<string>({ "x"s, "b"s, "c"s }));
+    second.PushBack("d"s);
+    second.PopBack();
+    assert(snapshot < second);
+
+    SharedSimpleVector<string> third = snapshot;
+    third.Clear();
+    assert(third.IsEmpty() && snapshot.GetSize() == 3 && !snapshot.IsShared());
+    third.PushBack("only"s);
+    assert(third.At(0) == "only"s);
+
+    SimpleVector<int> source(1000, 42);
+    const int* source_data = &source[0];
+    SharedSimpleVector<int> adopted(std::move(source));
+    assert(&as_const(adopted)[0] == source_data);
+
+    // Другой поток читает блок через свою копию и уничтожает её. После этого вектор снова единственный
+    // владелец и пишет в блок на месте, но его записи упорядочены после чтений того потока
+    for (int round = 0; round < 100; ++round) {
+        SharedSimpleVector<int> original(64, round);
+        int* unique_data = nullptr;
+        {
+            SharedSimpleVector<int> reader_copy = original;
+            thread reader([copy = std::move(reader_copy)]() mutable {
+                const SharedSimpleVector<int>& view = copy;
+                assert(accumulate(view.begin(), view.end(), 0) == 64 * view[0]);
+                copy = SharedSimpleVector<int>();
+            });
+            while (original.IsShared()) {
+                this_thread::yield();
+            }
+            unique_data = &original[0];
+            original[0] = -1;
+            reader.join();
+        }
+        assert(unique_data == &original[0] && original[0] == -1);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+struct StatsTestTag {};
+
+void TestStats() {
+    cout << "Test stats"s << endl;
+    using Stats = VectorStats<StatsTestTag>;
+    using CountedVector = SimpleVector<int, allocator<int>, DoublingGrowth, Stats>;
+    // Политика статистики не занимает места в векторе
+    static_assert(sizeof(CountedVector) == sizeof(SimpleVector<int>));
+    Stats::Reset();
+    {
+        CountedVector v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        StatsSnapshot snapshot = Stats::Snapshot();
+        // Вместимость растёт 1, 2, 4, ..., 128
+        assert(snapshot.allocations == 8 && snapshot.reallocations == 7);
+        assert(snapshot.peak_capacity == 128);
+        assert(snapshot.elements_relocated == 127 && snapshot.bytes_relocated == 127 * sizeof(int));
+        assert(snapshot.bytes_allocated == 255 * sizeof(int));
+        for (size_t k = 0; k < 8; ++k) {
+            assert(snapshot.growth_histogram[k] == 1);
+        }
+
+        CountedVector copy(v);
+        copy.Insert(copy.begin(), 5);
+        snapshot = Stats::Snapshot();
+        assert(snapshot.allocations == 10 && snapshot.elements_copied == 100);
+        assert(snapshot.peak_capacity == 200 && snapshot.growth_histogram[6] == 2 && snapshot.growth_histogram[7] == 2);
+
+        CountedVector reserved(Reserve(1000));
+        reserved.Append(v.begin(), v.end());
+        snapshot = Stats::Snapshot();
+        assert(snapshot.allocations == 11 && snapshot.reallocations == 8);
+        assert(snapshot.elements_copied == 200);
+        assert(reserved == v);
+    }
+    Stats::Reset();
+    assert(Stats::Snapshot().allocations == 0 && Stats::Snapshot().growth_histogram[7] == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+size_t CountSpaces(ConstSimpleVectorView<char> text) {
+    return static_cast<size_t>(count(text.begin(), text.end(), ' '));
+}
+
+void TestSimpleVectorView() {
+    cout << "Test simple vector view"s << endl;
+    const string source = "GET /index.html HTTP/1.1"s;
+    SimpleVector<char> payload(source.begin(), source.end());
+
+    // Вектор неявно превращается в представление, срезы указывают в его память
+    assert(CountSpaces(payload) == 2);
+    ConstSimpleVectorView<char> all = as_const(payload);
+    assert(all.GetSize() == payload.GetSize() && all.begin() == payload.Data());
+    ConstSimpleVectorView<char> method = all.First(3);
+    ConstSimpleVectorView<char> path = all.Subview(4, 11);
+    ConstSimpleVectorView<char> version = all.Last(8);
+    assert(string(method.begin(), method.end()) == "GET"s);
+    assert(string(path.begin(), path.end()) == "/index.html"s);
+    assert(string(version.begin(), version.end()) == "HTTP/1.1"s);
+    assert(path.begin() == payload.Data() + 4);
+    assert(all.Subview(20).GetSize() == 4 && all.Subview(all.GetSize()).IsEmpty());
+    assert(path.At(0) == '/');
+
+    try {
+        all.Subview(all.GetSize() + 1);
+        assert(false);
+    }
+    catch (const out_of_range&) {
+    }
+    try {
+        method.At(3);
+        assert(false);
+    }
+    catch (const out_of_range&) {
+    }
+    try {
+        method.Last(4);
+        assert(false);
+    }
+    catch (const out_of_range&) {
+    }
+
+    // Изменяемое представление пишет в вектор
+    SimpleVectorView<char> mutable_view = payload;
+    mutable_view.First(3)[0] = 'S';
+    mutable_view.Subview(1, 2)[1] = 'M';
+    assert(payload[0] == 'S' && payload[2] == 'M');
+
+    SimpleVector<int> numbers{ 1, 2, 3, 1, 2, 4 };
+    SimpleVectorView<int> numbers_view = numbers;
+    ConstSimpleVectorView<int> head = numbers_view.First(2);
+    assert(head == numbers_view.Subview(3, 2));
+    assert(numbers_view.First(3) < numbers_view.Last(3));
+    assert(numbers_view.Last(3) >= head && head != numbers_view);
+
+    // Вектор сравнивается с представлением напрямую, в любом порядке
+    const SimpleVector<int> prefix{ 1, 2 };
+    assert(prefix == head && head == prefix && numbers_view.First(2) == prefix);
+    assert(numbers != head && head != numbers && numbers == numbers_view);
+    assert(prefix < numbers_view && numbers_view > prefix && head <= prefix && prefix >= head);
+    assert(numbers_view.Last(3) > prefix && prefix < numbers_view.Last(3));
+    assert(!(numbers < numbers_view) && numbers <= numbers_view && numbers_view >= numbers);
+    assert(ConstSimpleVectorView<int>().IsEmpty());
+    cout << "Done!"s << endl << endl;
+}
+
+void TestEraseOperations() {
+    cout << "Test erase operations"s << endl;
+    {
+        SimpleVector<int> v(10);
+        iota(v.begin(), v.end(), 0);
+        auto it = v.Erase(v.begin() + 2, v.begin() + 5);
+        assert(*it == 5 && v == SimpleVector<int>({ 0, 1, 5, 6, 7, 8, 9 }));
+        it = v.Erase(v.begin() + 1, v.begin() + 1);
+        assert(*it == 1 && v.GetSize() == 7);
+        it = v.Erase(v.begin() + 4, v.end());
+        assert(it == v.end() && v == SimpleVector<int>({ 0, 1, 5, 6 }));
+
+        assert(v.EraseIf([](int x) { return x % 2 == 1; }) == 2);
+        assert(v == SimpleVector<int>({ 0, 6 }));
+
+        v = { 1, 2, 3, 4 };
+        it = v.SwapRemove(v.begin());
+        assert(*it == 4 && v == SimpleVector<int>({ 4, 2, 3 }));
+        it = v.SwapRemove(v.end() - 1);
+        assert(it == v.end() && v == SimpleVector<int>({ 4, 2 }));
+    }
+    Counted::ResetCounters();
+    {
+        SimpleVector<Counted> v(100);
+        v.Erase(v.begin() + 10, v.begin() + 30);
+        assert(v.GetSize() == 80 && Counted::constructed - Counted::destroyed == 80);
+        size_t index = 0;
+        assert(v.EraseIf([&index](const Counted&) { return index++ % 4 == 0; }) == 20);
+        assert(v.GetSize() == 60 && Counted::constructed - Counted::destroyed == 60);
+        v.SwapRemove(v.begin() + 5);
+        assert(Counted::constructed - Counted::destroyed == 59);
+    }
+    assert(Counted::constructed == Counted::destroyed);
+    {
+        // Стабильное удаление сохраняет порядок нетривиальных элементов
+        SimpleVector<string> v;
+        for (int i = 0; i < 20; ++i) {
+            v.PushBack("item number "s + to_string(i));
+        }
+        v.EraseIf([](const string& s) { return s.back() == '3' || s.back() == '7'; });
+        assert(v.GetSize() == 16 && v[3] == "item number 4"s && v[15] == "item number 19"s);
+        v.Erase(v.begin(), v.begin() + 15);
+        assert(v.GetSize() == 1 && v[0] == "item number 19"s);
+        v.SwapRemove(v.begin());
+        assert(v.IsEmpty());
+
+        SimpleVector<Boxed> boxes;
+        for (size_t i = 0; i < 5; ++i) {
+            boxes.PushBack(Boxed{ make_unique<size_t>(i) });
+        }
+        boxes.SwapRemove(boxes.begin() + 1);
+        boxes.Erase(boxes.begin(), boxes.begin() + 2);
+        assert(boxes.GetSize() == 2 && *boxes[0].value == 2 && *boxes[1].value == 3);
+    }
+    {
+        SmallSimpleVector<int, 4> v{ 1, 2, 3, 4, 5, 6 };
+        v.Erase(v.begin(), v.begin() + 2);
+        v.EraseIf([](int x) { return x == 5; });
+        v.SwapRemove(v.begin());
+        assert(v.GetSize() == 2 && v[0] == 6 && v[1] == 4);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAlignedAllocators() {
+    cout << "Test aligned allocators"s << endl;
+    {
+        SimpleVector<float, AlignedAllocator<float, 64>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(reinterpret_cast<uintptr_t>(v.Data()) % 64 == 0);
+        }
+        v.Insert(v.begin(), -1.0f);
+        assert(reinterpret_cast<uintptr_t>(v.Data()) % 64 == 0);
+        assert(v.GetSize() == 1001 && v[0] == -1.0f && v[1000] == 999.0f);
+
+        SimpleVector<float, AlignedAllocator<float, 64>> copy = v;
+        assert(copy == v && reinterpret_cast<uintptr_t>(copy.Data()) % 64 == 0);
+    }
+    {
+        // Порог в 64 КБ, чтобы проверить путь с отдельным отображением на небольших данных
+        using HugeVector = SimpleVector<int, HugePageAllocator<int, 64 * 1024>, PageRoundedGrowth<DoublingGrowth, 2 << 20>>;
+        HugeVector v(10);
+        assert(reinterpret_cast<uintptr_t>(v.Data()) % 64 == 0);
+        for (int i = 0; i < 1'000'000; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.GetCapacity() * sizeof(int) % (2 << 20) == 0);
+#if defined(__linux__)
+        assert(reinterpret_cast<uintptr_t>(v.Data()) % (2 << 20) == 0);
+#endif
+        assert(v[10] == 0 && v[1'000'009] == 999'999);
+        v.Resize(5);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 5 && v[4] == 0);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSoaSimpleVector() {
+    cout << "Test structure of arrays"s << endl;
+    SoaSimpleVector<int, double, string> particles;
+    assert(particles.IsEmpty() && particles.GetCapacity() == 0);
+    for (int i = 0; i < 100; ++i) {
+        particles.PushBack({ i, i * 0.5, "particle "s + to_string(i) });
+    }
+    particles.EmplaceBack(100, 50.0, "last"s);
+    assert(particles.GetSize() == 101 && particles.GetCapacity() == 128);
+
+    // Каждый столбец лежит в отдельном непрерывном массиве
+    ConstSimpleVectorView<double> masses = as_const(particles).Column<1>();
+    assert(masses.GetSize() == 101 && masses[10] == 5.0);
+    assert(accumulate(masses.begin(), masses.end(), 0.0) == 2525.0);
+    SimpleVectorView<int> ids = particles.Column<0>();
+    for (int& id : ids) {
+        id *= 2;
+    }
+
+    auto [id, mass, name] = particles[3];
+    assert(id == 6 && mass == 1.5 && name == "particle 3"s);
+    name = "renamed"s;
+    assert(get<2>(particles.At(3)) == "renamed"s);
+
+    size_t count = 0;
+    for (auto [record_id, record_mass, record_name] : as_const(particles)) {
+        assert(record_mass * 4 == record_id);
+        ++count;
+    }
+    assert(count == particles.GetSize());
+    auto it = particles.begin() + 5;
+    get<1>(*it) = -1.0;
+    assert(particles.end() - it == 96 && get<1>(particles[5]) == -1.0);
+    SoaSimpleVector<int, double, string>::ConstIterator const_it = it;
+    assert(const_it == particles.cbegin() + 5 && const_it[1] == particles[6]);
+
+    // Аргумент ссылается на запись самого вектора, а добавление перевыделяет память
+    particles.Resize(particles.GetCapacity());
+    assert(get<2>(particles[127]).empty());
+    particles.PushBack(as_const(particles)[0]);
+    assert(get<2>(particles[128]) == "particle 0"s);
+
+    SoaSimpleVector<int, double, string> copy = particles;
+    assert(copy.GetSize() == particles.GetSize() && copy[3] == particles[3]);
+    particles.PopBack();
+    particles.Resize(10);
+    SoaSimpleVector<int, double, string> moved = std::move(particles);
+    assert(moved.GetSize() == 10 && particles.IsEmpty());
+    copy.swap(moved);
+    assert(copy.GetSize() == 10 && moved.GetSize() == 129);
+    copy.Clear();
+    assert(copy.IsEmpty());
+    try {
+        copy.At(0);
+        assert(false);
+    }
+    catch (const out_of_range&) {
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSegmentedSimpleVector() {
+    cout << "Test segmented vector"s << endl;
+    {
+        SegmentedSimpleVector<int, 8> v;
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        v.PushBack(0);
+        const int* first = &v[0];
+        for (int i = 1; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        // Рост добавляет блоки и не перемещает уже созданные элементы
+        assert(&v[0] == first);
+        assert(v.GetSize() == 100 && v.GetCapacity() == 104);
+        for (size_t i = 0; i < v.GetSize(); ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
+        assert(accumulate(v.begin(), v.end(), 0) == 4950);
+        assert(v.end() - v.begin() == 100 && *(v.begin() + 42) == 42 && v.begin()[99] == 99);
+        assert(is_sorted(v.cbegin(), v.cend()));
+
+        // Аргумент ссылается на элемент этого же вектора на границе блока
+        v.Resize(104);
+        v.PushBack(v[7]);
+        assert(v.GetSize() == 105 && v[104] == 7);
+
+        SimpleVector<int> flat = v.ToSimpleVector();
+        assert(flat.GetSize() == 105 && flat[50] == 50);
+        SegmentedSimpleVector<int, 8> copy = v;
+        assert(copy == v);
+        copy[3] = -1;
+        assert(copy < v && copy != v);
+
+        v.Resize(10);
+        assert(v.GetCapacity() == 112);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 16);
+        SimpleVector<int> moved = v.Flatten();
+        assert(moved.GetSize() == 10 && moved[9] == 9);
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        try {
+            v.At(0);
+            assert(false);
+        }
+        catch (const out_of_range&) {
+        }
+    }
+    {
+        SegmentedSimpleVector<string> names{ "a"s, "b"s };
+        names.Reserve(1000);
+        assert(names.GetCapacity() >= 1000);
+        const string* a = &names[0];
+        while (names.GetSize() < 1000) {
+            names.EmplaceBack(5, 'x');
+        }
+        assert(&names[0] == a && names[999] == "xxxxx"s);
+        SegmentedSimpleVector<string> other(ReserveProxyObj(10));
+        other.swap(names);
+        assert(names.IsEmpty() && other.GetSize() == 1000);
+        SimpleVector<string> flat = other.Flatten();
+        assert(flat.GetSize() == 1000 && flat[1] == "b"s && other.IsEmpty());
+        SegmentedSimpleVector<string> filled(300, "y"s);
+        assert(filled.GetSize() == 300 && filled[299] == "y"s);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+constexpr StaticSimpleVector<int, 32> MakeSquares() {
+    StaticSimpleVector<int, 32> squares;
+    for (int i = 0; !squares.IsFull(); ++i) {
+        squares.PushBack(i * i);
+    }
+    squares.PopBack();
+    return squares;
+}
+
+void TestStaticSimpleVector() {
+    cout << "Test static vector"s << endl;
+    {
+        // Таблица строится компилятором
+        constexpr StaticSimpleVector<int, 32> kSquares = MakeSquares();
+        static_assert(kSquares.GetSize() == 31 && kSquares[30] == 900);
+        static_assert(*(kSquares.end() - 1) == 900 && kSquares.At(5) == 25);
+        static_assert(StaticSimpleVector<char, 4>{ 'a', 'b' }.GetSize() == 2);
+        static_assert(std::is_trivially_copyable_v<StaticSimpleVector<int, 32>>);
+        assert(accumulate(kSquares.begin(), kSquares.end(), 0) == 9455);
+
+        StaticSimpleVector<int, 32> copy = kSquares;
+        assert(copy == kSquares && !(copy < kSquares));
+        copy.Erase(copy.begin());
+        copy.Insert(copy.begin() + 2, 3);
+        assert(copy[0] == 1 && copy[2] == 3 && copy[3] == 9 && copy.GetSize() == 31);
+        assert(copy.TryPushBack(1) && copy.IsFull());
+        assert(!copy.TryPushBack(2) && copy.TryEmplaceBack(3) == nullptr);
+        try {
+            copy.PushBack(4);
+            assert(false);
+        }
+        catch (const length_error&) {
+        }
+        assert(copy.GetSize() == 32 && copy.EraseIf([](int x) { return x % 2 == 0; }) == 15);
+        copy.SwapRemove(copy.begin());
+        assert(copy.GetSize() == 16 && copy[0] == 1);
+    }
+    {
+        StaticSimpleVector<string, 4> names{ "a"s, "b"s, "c"s };
+        try {
+            StaticSimpleVector<string, 4> too_many(5, "x"s);
+            assert(false);
+        }
+        catch (const length_error&) {
+        }
+        names.EmplaceBack(3, 'd');
+        assert(names.IsFull() && names[3] == "ddd"s);
+        StaticSimpleVector<string, 4> other{ "x"s };
+        other.swap(names);
+        assert(names.GetSize() == 1 && names[0] == "x"s);
+        assert(other.GetSize() == 4 && other[0] == "a"s && other[3] == "ddd"s);
+        StaticSimpleVector<string, 4> copy = other;
+        copy.Erase(copy.begin() + 1, copy.begin() + 3);
+        assert(copy.GetSize() == 2 && copy[1] == "ddd"s && other.GetSize() == 4);
+        copy = names;
+        assert(copy == names);
+        copy.Resize(3);
+        assert(copy[2].empty());
+        copy.Clear();
+        assert(copy.IsEmpty());
+        try {
+            copy.At(0);
+            assert(false);
+        }
+        catch (const out_of_range&) {
+        }
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestStrongGuaranteeGrowth() {
+    cout << "Test strong guarantee on growth"s << endl;
+    {
+        // Перемещение может выбросить исключение, поэтому при росте элементы копируются
+        SimpleVector<ThrowingCopy> v;
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        ThrowingCopy::copies = 0;
+        ThrowingCopy::moves = 0;
+        v.Reserve(16);
+        assert(ThrowingCopy::copies == 4 && ThrowingCopy::moves == 0);
+
+        v.Resize(16);
+        ThrowingCopy::copies_before_throw = 10;
+        try {
+            v.PushBack(ThrowingCopy(100));
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+        ThrowingCopy::copies_before_throw = SIZE_MAX;
+        // Вектор остался прежним: ни один исходный элемент не был перемещён
+        assert(v.GetSize() == 16 && v.GetCapacity() == 16);
+        for (int i = 0; i < 4; ++i) {
+            assert(v[i].value == i);
+        }
+
+        ThrowingCopy::copies_before_throw = 3;
+        try {
+            v.Insert(v.begin() + 8, ThrowingCopy(200));
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+        ThrowingCopy::copies_before_throw = SIZE_MAX;
+        assert(v.GetSize() == 16 && v[3].value == 3 && v[8].value == 0);
+    }
+    {
+        // noexcept-перемещения переносятся без копий
+        SimpleVector<string> v;
+        v.PushBack(string(100, 'a'));
+        const char* data = v[0].data();
+        v.Reserve(100);
+        assert(v[0].data() == data);
+    }
+    {
+        // Только перемещаемый тип с перемещением без noexcept всё равно перемещается
+        SimpleVector<X> v;
+        v.EmplaceBack(1);
+        v.Reserve(10);
+        v.EmplaceBack(2);
+        v.Insert(v.begin(), X(3));
+        assert(v.GetSize() == 3 && v[0].GetX() == 3 && v[1].GetX() == 1 && v[2].GetX() == 2);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestResizeVariants() {
+    cout << "Test resize with value and without initialization"s << endl;
+    {
+        SimpleVector<string> v{ "a"s, "b"s };
+        v.Resize(5, "x"s);
+        assert(v.GetSize() == 5 && v[1] == "b"s && v[4] == "x"s);
+        // Значение ссылается на элемент, который переносится при росте
+        v.Resize(40, v[0]);
+        assert(v.GetSize() == 40 && v[39] == "a"s && v[4] == "x"s);
+        v.Resize(3, "y"s);
+        assert(v.GetSize() == 3 && v[2] == "x"s);
+        v.Resize(4, v[1]);
+        assert(v[3] == "b"s);
+    }
+    {
+        Counted::ResetCounters();
+        {
+            SimpleVector<Counted> v;
+            v.ResizeDefaultInit(10);
+            assert(v.GetSize() == 10 && Counted::constructed == 10);
+            v.ResizeDefaultInit(2);
+            assert(Counted::destroyed == 8);
+        }
+        assert(Counted::constructed == Counted::destroyed);
+    }
+    {
+        SimpleVector<unsigned char> buffer;
+        buffer.Reserve(64);
+        unsigned char* data = buffer.AppendUninitialized(16);
+        assert(data == buffer.Data() && buffer.GetSize() == 16);
+        memset(data, 0xAB, 16);
+        // Память под новыми элементами не обнуляется
+        buffer.Resize(0);
+        buffer.ResizeDefaultInit(16);
+        assert(buffer[0] == 0xAB && buffer[15] == 0xAB);
+
+        unsigned char* tail = buffer.AppendUninitialized(100);
+        assert(buffer.GetSize() == 116 && tail == buffer.Data() + 16);
+        memset(tail, 1, 100);
+        assert(accumulate(buffer.begin() + 16, buffer.end(), 0) == 100);
+        buffer.ResizeDefaultInit(500);
+        assert(buffer.GetSize() == 500 && buffer[0] == 0xAB);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+// Сравнение, которое выбрасывает исключение на заданном по счёту вызове
+struct ThrowingLess {
+    static inline int calls_before_throw = -1;
+
+    bool operator()(const string& lhs, const string& rhs) const {
+        if (calls_before_throw == 0) {
+            throw runtime_error("comparison failed");
+        }
+        if (calls_before_throw > 0) {
+            --calls_before_throw;
+        }
+        return lhs < rhs;
+    }
+};
+
+void TestFlatContainers() {
+    cout << "Test flat set and map"s << endl;
+    {
+        // Исключение из сравнения на любом шаге InsertRange оставляет контейнеры прежними
+        const array<string, 5> more = { "delta"s, "alpha"s, "echo"s, "bravo"s, "delta"s };
+        bool completed_set = false;
+        bool completed_map = false;
+        for (int limit = 0; !(completed_set && completed_map); ++limit) {
+            ThrowingLess::calls_before_throw = -1;
+            FlatSet<string, ThrowingLess> set{ "charlie"s, "alpha"s, "foxtrot"s };
+            const SimpleVector<string> keys_before = set.Keys();
+            FlatMap<string, string, ThrowingLess> map;
+            map.Insert("charlie"s, "3"s);
+            map.Insert("foxtrot"s, "6"s);
+            const FlatMap<string, string, ThrowingLess> map_before = map;
+
+            ThrowingLess::calls_before_throw = limit;
+            try {
+                set.InsertRange(more.begin(), more.end());
+                completed_set = true;
+                assert(set.Keys() == SimpleVector<string>({ "alpha"s, "bravo"s, "charlie"s, "delta"s, "echo"s, "foxtrot"s }));
+            }
+            catch (const runtime_error&) {
+                assert(set.Keys() == keys_before);
+            }
+            ThrowingLess::calls_before_throw = limit;
+            try {
+                const array<pair<string, string>, 3> pairs = { pair{ "echo"s, "5"s }, pair{ "alpha"s, "1"s }, pair{ "charlie"s, "x"s } };
+                map.InsertRange(pairs.begin(), pairs.end());
+                completed_map = true;
+                ThrowingLess::calls_before_throw = -1;
+                assert(map.GetSize() == 4 && map.At("charlie"s) == "3"s && map.At("echo"s) == "5"s);
+            }
+            catch (const runtime_error&) {
+                ThrowingLess::calls_before_throw = -1;
+                assert(map == map_before);
+            }
+        }
+        ThrowingLess::calls_before_throw = -1;
+    }
+    {
+        FlatSet<int> set{ 5, 1, 3, 1, 9 };
+        assert(set.GetSize() == 4 && is_sorted(set.begin(), set.end()));
+        assert(set.Contains(3) && !set.Contains(4) && set.Find(4) == set.end());
+        assert(*set.LowerBound(4) == 5 && set.LowerBound(10) == set.end() && *set.LowerBound(0) == 1);
+        assert(set.Insert(4).second && !set.Insert(4).second);
+        assert(*set.Insert(0).first == 0 && set.GetSize() == 6);
+
+        const int more[] = { 8, 2, 9, 2, 7, 100 };
+        set.InsertRange(begin(more), end(more));
+        const SimpleVector<int> expected{ 0, 1, 2, 3, 4, 5, 7, 8, 9, 100 };
+        assert(set.Keys() == expected);
+        assert(set.Erase(3) == 1 && set.Erase(3) == 0);
+        assert(*set.Erase(set.Find(7)) == 8 && set.GetSize() == 8);
+
+        // Нижняя граница без ветвлений совпадает с std::lower_bound на всех позициях
+        SimpleVector<int> sorted(257);
+        for (size_t i = 0; i < sorted.GetSize(); ++i) {
+            sorted[i] = static_cast<int>(i * 2);
+        }
+        for (size_t size = 0; size <= sorted.GetSize(); ++size) {
+            for (int key = -1; key <= static_cast<int>(size * 2); ++key) {
+                const size_t expected_index = lower_bound(sorted.begin(), sorted.begin() + size, key) - sorted.begin();
+                assert(detail::BranchlessLowerBound(sorted.Data(), size, key, less<int>()) == expected_index);
+            }
+        }
+    }
+    {
+        FlatSet<string, greater<string>> names{ "b"s, "c"s, "a"s };
+        assert(*names.begin() == "c"s && names.Contains("a"s));
+    }
+    {
+        FlatMap<string, int> routes{ { "b"s, 2 }, { "a"s, 1 }, { "b"s, 20 } };
+        assert(routes.GetSize() == 2 && routes.At("b"s) == 2);
+        routes["c"s] = 3;
+        ++routes["a"s];
+        assert(routes.At("a"s) == 2 && routes.GetSize() == 3);
+        assert(!routes.Insert("c"s, 30).second && routes.At("c"s) == 3);
+        assert(!routes.InsertOrAssign("c"s, 30).second && routes.At("c"s) == 30);
+        assert(routes.TryEmplace("d"s, 4).second);
+
+        const SimpleVector<string> expected_keys{ "a"s, "b"s, "c"s, "d"s };
+        assert(routes.Keys() == expected_keys);
+        int sum = 0;
+        for (auto [key, value] : routes) {
+            sum += value;
+            value = 0;
+        }
+        assert(sum == 2 + 2 + 30 + 4 && routes.At("d"s) == 0);
+
+        map<string, int> extra{ { "a"s, 100 }, { "e"s, 5 }, { "0"s, -1 } };
+        routes.InsertRange(extra.begin(), extra.end());
+        const SimpleVector<string> merged_keys{ "0"s, "a"s, "b"s, "c"s, "d"s, "e"s };
+        assert(routes.Keys() == merged_keys && routes.At("a"s) == 0 && routes.At("e"s) == 5);
+
+        assert(routes.Erase("b"s) == 1 && !routes.Contains("b"s));
+        auto it = routes.Erase(routes.Find("0"s));
+        assert((*it).first == "a"s && routes.GetSize() == 4);
+        const auto& const_routes = routes;
+        assert(const_routes.Find("zzz"s) == const_routes.end());
+        try {
+            const_routes.At("zzz"s);
+            assert(false);
+        }
+        catch (const out_of_range&) {
+        }
+        FlatMap<string, int> copy = routes;
+        assert(copy == routes);
+        copy.Clear();
+        assert(copy.IsEmpty() && copy != routes);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestBatchExchange() {
+    cout << "Test batch exchange"s << endl;
+    {
+        BatchExchange<int> exchange(8);
+        SimpleVector<int> produced{ 1, 2, 3 };
+        SimpleVector<int> consumed;
+        assert(!exchange.TryTake(consumed));
+
+        assert(exchange.TryPublish(produced));
+        // Производитель получил пустой вектор из ячейки вместе с его вместимостью
+        assert(produced.IsEmpty() && produced.GetCapacity() == 8);
+        produced.PushBack(4);
+        // Пока прошлый пакет не забран, новый не публикуется
+        assert(!exchange.TryPublish(produced) && produced.GetSize() == 1);
+
+        const int* first_batch = nullptr;
+        assert(exchange.TryTake(consumed) && consumed == SimpleVector<int>({ 1, 2, 3 }));
+        first_batch = consumed.Data();
+        assert(exchange.TryPublish(produced));
+        assert(exchange.TryTake(consumed) && consumed == SimpleVector<int>{ 4 });
+        // Память обработанного пакета вернулась производителю
+        produced.PushBack(5);
+        assert(exchange.TryPublish(produced) && produced.IsEmpty() && produced.Data() == first_batch);
+
+        exchange.Close();
+        assert(exchange.IsClosed());
+        assert(exchange.Take(consumed) && consumed == SimpleVector<int>{ 5 });
+        assert(!exchange.Take(consumed) && consumed.GetSize() == 1);
+    }
+    {
+        SimpleVector<string> words;
+        const array<string, 3> source = { "a"s, "b"s, "c"s };
+        copy(source.begin(), source.end(), BackInserter(words));
+        assert(words == SimpleVector<string>({ "a"s, "b"s, "c"s }));
+    }
+    {
+        // В конвейере память выделяется только в начале: по разу на каждый из трёх векторов в обороте
+        using Stats = VectorStats<struct BatchExchangeTag>;
+        Stats::Reset();
+        const size_t batch_size = 256;
+        const int count = 100'000;
+        BatchExchange<int, std::allocator<int>, DoublingGrowth, Stats> exchange(batch_size);
+        thread producer_thread([&] {
+            BatchProducer<int, std::allocator<int>, DoublingGrowth, Stats> producer(exchange, batch_size);
+            for (int i = 0; i < count / 2; ++i) {
+                producer.PushBack(i);
+            }
+            SimpleVector<int> rest(count / 2);
+            iota(rest.begin(), rest.end(), count / 2);
+            copy(rest.begin(), rest.end(), BackInserter(producer));
+            producer.Close();
+        });
+        SimpleVector<int, std::allocator<int>, DoublingGrowth, Stats> batch;
+        int expected = 0;
+        size_t batches = 0;
+        while (exchange.Take(batch)) {
+            assert(batch.GetSize() <= batch_size);
+            for (int value : batch) {
+                assert(value == expected);
+                ++expected;
+            }
+            ++batches;
+        }
+        producer_thread.join();
+        assert(expected == count && batches == (count + batch_size - 1) / batch_size);
+        assert(Stats::Snapshot().allocations == 3);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestHashing() {
+    cout << "Test hashing"s << endl;
+    {
+        // Отпечаток зависит только от содержимого, но не от вместимости
+        SimpleVector<int> a{ 1, 2, 3 };
+        SimpleVector<int> b(Reserve(100));
+        b.PushBack(1);
+        b.PushBack(2);
+        b.PushBack(3);
+        assert(a == b && a.Fingerprint() == b.Fingerprint());
+        assert(hash<SimpleVector<int>>{}(a) == static_cast<size_t>(a.Fingerprint()));
+        b.PopBack();
+        assert(a.Fingerprint() != b.Fingerprint());
+        assert(SimpleVector<int>{}.Fingerprint() == SimpleVector<int>(Reserve(8)).Fingerprint());
+        assert(SimpleVector<int>({ 1, 2 }).Fingerprint() != SimpleVector<int>({ 2, 1 }).Fingerprint());
+        static_assert(noexcept(a.Fingerprint()));
+    }
+    {
+        // Каждая длина и каждый байт влияют на результат, в том числе в хвостах короче 16 байт
+        SimpleVector<uint8_t> bytes(200);
+        iota(bytes.begin(), bytes.end(), uint8_t{ 1 });
+        unordered_set<uint64_t> prefixes;
+        for (size_t size = 0; size <= bytes.GetSize(); ++size) {
+            prefixes.insert(detail::HashBytes(bytes.Data(), size));
+        }
+        assert(prefixes.size() == bytes.GetSize() + 1);
+        const uint64_t original = bytes.Fingerprint();
+        for (size_t i = 0; i < bytes.GetSize(); ++i) {
+            bytes[i] ^= 0x10;
+            assert(bytes.Fingerprint() != original);
+            bytes[i] ^= 0x10;
+        }
+        assert(bytes.Fingerprint() == original);
+        // Результат не зависит от выравнивания данных
+        SimpleVector<uint8_t> shifted(bytes.GetSize() + 1);
+        memcpy(shifted.Data() + 1, bytes.Data(), bytes.GetSize());
+        assert(detail::HashBytes(shifted.Data() + 1, bytes.GetSize()) == original);
+        assert(detail::HashBytes(bytes.Data(), bytes.GetSize(), 1) != original);
+
+        // Результат хранится в сериализованных векторах, поэтому не должен меняться. Значения даны для little-endian
+        const uint16_t byte_order_probe = 1;
+        if (*reinterpret_cast<const uint8_t*>(&byte_order_probe) == 1) {
+            assert(detail::HashBytes(bytes.Data(), 0) == 0x93228a4de0eec5a2ull);
+            assert(detail::HashBytes(bytes.Data(), 3) == 0x1e95b2fb296ed0e9ull);
+            assert(detail::HashBytes(bytes.Data(), 16) == 0x9833d60d1b0fc71cull);
+            assert(detail::HashBytes(bytes.Data(), 200) == 0x2964347a79efa509ull);
+        }
+    }
+    {
+        // Элементы без побайтового равенства хешируются через std::hash
+        SimpleVector<string> words{ "alpha"s, "beta"s };
+        SimpleVector<string> same{ "alpha"s, "beta"s };
+        assert(words.Fingerprint() == same.Fingerprint());
+        same[1] = "gamma"s;
+        assert(words.Fingerprint() != same.Fingerprint());
+        assert(SimpleVector<double>{ 0.0 }.Fingerprint() == SimpleVector<double>{ -0.0 }.Fingerprint());
+
+        SimpleVector<SimpleVector<int>> nested{ { 1 }, { 2, 3 } };
+        SimpleVector<SimpleVector<int>> regrouped{ { 1, 2 }, { 3 } };
+        assert(nested.Fingerprint() != regrouped.Fingerprint());
+    }
+    {
+        unordered_map<SimpleVector<int>, string> cache;
+        cache[SimpleVector<int>{ 1, 2, 3 }] = "first"s;
+        cache[SimpleVector<int>{ 3, 2, 1 }] = "second"s;
+        SimpleVector<int> key;
+        for (int i = 1; i <= 3; ++i) {
+            key.PushBack(i);
+        }
+        assert(cache.size() == 2 && cache.at(key) == "first"s);
+        unordered_set<SimpleVector<string>> sets{ SimpleVector<string>{ "x"s }, SimpleVector<string>{ "x"s } };
+        assert(sets.size() == 1);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+// Полностью проверяется в сборке с -DSIMPLE_VECTOR_DEBUG -fsanitize=address
+void TestDebugMode() {
+    cout << "Test debug mode"s << endl;
+#if defined(SIMPLE_VECTOR_DEBUG)
+    {
+        SimpleVector<int> v;
+        v.Reserve(4);
+        v.PushBack(1);
+        SimpleVector<int>::Iterator it = v.begin();
+        SimpleVector<int>::ConstIterator const_it = it;
+        assert(it.IsValidFor(&v) && const_it.IsValidFor(&v));
+        // Без перевыделения итераторы остаются действительными
+        v.PushBack(2);
+        assert(it.IsValidFor(&v) && *it == 1 && const_it[1] == 2);
+        v.Reserve(100);
+        assert(!it.IsValidFor(&v) && !const_it.IsValidFor(&v));
+
+        it = v.begin();
+        SimpleVector<int> moved = std::move(v);
+        assert(!it.IsValidFor(&v) && !it.IsValidFor(&moved));
+        assert(moved.begin().IsValidFor(&moved) && moved.end() - moved.begin() == 2);
+    }
+#if defined(SIMPLE_VECTOR_ANNOTATE_CONTAINER)
+    {
+        // Свободная вместимость недоступна, пока в неё не записан элемент
+        SimpleVector<int64_t> v;
+        v.Reserve(8);
+        assert(__asan_address_is_poisoned(v.Data()));
+        v.PushBack(1);
+        v.PushBack(2);
+        assert(!__asan_address_is_poisoned(v.Data() + 1) && __asan_address_is_poisoned(v.Data() + 2));
+        v.PopBack();
+        assert(__asan_address_is_poisoned(v.Data() + 1));
+        v.Resize(5);
+        assert(!__asan_address_is_poisoned(v.Data() + 4) && __asan_address_is_poisoned(v.Data() + 5));
+        v.Erase(v.begin() + 1, v.end());
+        assert(__asan_address_is_poisoned(v.Data() + 1));
+        v.Clear();
+        assert(__asan_address_is_poisoned(v.Data()));
+
+        // Разметка переходит вместе с буфером
+        v.PushBack(3);
+        SimpleVector<int64_t> other;
+        other.swap(v);
+        assert(!__asan_address_is_poisoned(other.Data()) && __asan_address_is_poisoned(other.Data() + 1));
+        SimpleVector<int64_t> moved = std::move(other);
+        assert(!__asan_address_is_poisoned(moved.Data()) && __asan_address_is_poisoned(moved.Data() + 1));
+        moved.ShrinkToFit();
+        assert(moved.GetCapacity() == 1 && !__asan_address_is_poisoned(moved.Data()));
+    }
+    {
+        // Если элемент не удалось создать, открытая под него ячейка снова недоступна
+        SimpleVector<ThrowingCopy> v;
+        v.Reserve(4);
+        v.EmplaceBack(1);
+        const ThrowingCopy value(2);
+        ThrowingCopy::copies_before_throw = 0;
+        auto expect_throw = [&](auto operation) {
+            try {
+                operation();
+                assert(false);
+            }
+            catch (const runtime_error&) {
+            }
+            assert(v.GetSize() == 1 && __asan_address_is_poisoned(v.Data() + v.GetSize()));
+        };
+        expect_throw([&] { v.EmplaceBack(value); });
+        expect_throw([&] { v.Emplace(v.end(), value); });
+        expect_throw([&] { v.Emplace(v.begin(), value); });
+        expect_throw([&] { v.Resize(3, value); });
+        ThrowingCopy::copies_before_throw = SIZE_MAX;
+    }
+#endif
+#else
+    // В обычной сборке итераторы — указатели, и вектор не хранит ничего сверх буфера и размера
+    static_assert(is_same_v<SimpleVector<int>::Iterator, int*>);
+    static_assert(sizeof(SimpleVector<int>) == sizeof(RawStorage<int>) + sizeof(size_t));
+#endif
+    cout << "Done!"s << endl << endl;
+}
+
 int main() {
     TestTemporaryObjConstructor();
     TestTemporaryObjOperator();
@@ -159,5 +1778,32 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestUninitializedCapacity();
+    TestEmplace();
+    TestTriviallyRelocatable();
+    TestAllocator();
+    TestSmallSimpleVector();
+    TestGrowthPolicy();
+    TestRangeOperations();
+    TestArithmeticComparisons();
+    TestParallelAlgorithms();
+    TestConcurrentSimpleVector();
+    TestMmapSimpleVector();
+    TestSerialization();
+    TestShrinkToFit();
+    TestSharedSimpleVector();
+    TestStats();
+    TestSimpleVectorView();
+    TestEraseOperations();
+    TestAlignedAllocators();
+    TestSoaSimpleVector();
+    TestSegmentedSimpleVector();
+    TestStaticSimpleVector();
+    TestStrongGuaranteeGrowth();
+    TestResizeVariants();
+    TestFlatContainers();
+    TestDebugMode();
+    TestBatchExchange();
+    TestHashing();
     return 0;
 }
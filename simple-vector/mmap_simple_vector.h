@@ -0,0 +1,362 @@
+#pragma once
+
+#include "growth_policy.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Подсказки ядру о том, как будут читаться элементы (madvise)
+enum class MmapAdvice {
+    kNormal,
+    kSequential,
+    kRandom,
+    kWillNeed,
+};
+
+// MmapSimpleVector — вектор тривиально копируемых элементов, хранящихся прямо в отображённом в память файле.
+// Открытие существующего файла ничего не читает и не копирует: страницы подгружаются при первом обращении
+// и разделяются через page cache с другими процессами, отобразившими тот же файл.
+// Вместимость растёт через ftruncate и mremap (на системах без mremap — повторным отображением).
+// Размер хранится в заголовке файла, поэтому после перезапуска вектор открывается в том же состоянии.
+// Ошибки системных вызовов выбрасываются как std::system_error. Только POSIX.
+// Перемещённый вектор не связан с файлом и пуст: Clear, PopBack, Flush и Advise ничего не делают,
+// а Resize, EmplaceBack и Reserve выбрасывают std::logic_error. Связать его с файлом снова можно присваиванием
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+class MmapSimpleVector {
+    static_assert(std::is_trivially_copyable_v<Type>, "MmapSimpleVector stores elements as raw bytes");
+    static_assert(alignof(Type) <= 64, "Elements are stored right after a 64-byte header");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Открывает файл path, создавая его при отсутствии. Существующий файл должен быть создан
+    // MmapSimpleVector с тем же размером элемента, иначе выбрасывается std::runtime_error
+    explicit MmapSimpleVector(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        try {
+            Open();
+        }
+        catch (...) {
+            Close();
+            throw;
+        }
+    }
+
+    MmapSimpleVector(const MmapSimpleVector&) = delete;
+    MmapSimpleVector& operator=(const MmapSimpleVector&) = delete;
+
+    MmapSimpleVector(MmapSimpleVector&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , mapping_(std::exchange(other.mapping_, nullptr))
+        , mapped_bytes_(std::exchange(other.mapped_bytes_, 0))
+    {}
+
+    MmapSimpleVector& operator=(MmapSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Close();
+            fd_ = std::exchange(rhs.fd_, -1);
+            mapping_ = std::exchange(rhs.mapping_, nullptr);
+            mapped_bytes_ = std::exchange(rhs.mapped_bytes_, 0);
+        }
+        return *this;
+    }
+
+    // Снимает отображение и закрывает файл. Изменения остаются в page cache и попадут на диск,
+    // но надёжно сохранены будут только после Flush
+    ~MmapSimpleVector() {
+        Close();
+    }
+
+    // Перемещённый вектор не связан с файлом и пуст
+    size_t GetSize() const noexcept {
+        return mapping_ != nullptr ? GetHeader().size : 0;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return mapping_ != nullptr ? (mapped_bytes_ - kHeaderSize) / sizeof(Type) : 0;
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    Type& operator[](size_t index) noexcept {
+        assert(index < GetSize());
+        return Data()[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return Data()[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("index > size_");
+        }
+        return Data()[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("index > size_");
+        }
+        return Data()[index];
+    }
+
+    Iterator begin() noexcept {
+        return Data();
+    }
+
+    Iterator end() noexcept {
+        return Data() + GetSize();
+    }
+
+    ConstIterator begin() const noexcept {
+        return Data();
+    }
+
+    ConstIterator end() const noexcept {
+        return Data() + GetSize();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Обнуляет размер, не уменьшая файл
+    void Clear() noexcept {
+        if (mapping_ != nullptr) {
+            GetHeader().size = 0;
+        }
+    }
+
+    // Новые элементы инициализируются значением по умолчанию
+    void Resize(size_t new_size) {
+        RequireMapping();
+        const size_t size = GetSize();
+        if (new_size > size) {
+            if (new_size > GetCapacity()) {
+                Remap(GrowthPolicy::NextCapacity(GetCapacity(), new_size, sizeof(Type)));
+            }
+            for (size_t i = size; i < new_size; ++i) {
+                new (Data() + i) Type();
+            }
+        }
+        GetHeader().size = new_size;
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        RequireMapping();
+        const size_t size = GetSize();
+        if (size == GetCapacity()) {
+            // Элемент создаётся до перевыделения, так как args могут ссылаться на текущее отображение
+            const Type item(std::forward<Args>(args)...);
+            Remap(GrowthPolicy::NextCapacity(GetCapacity(), size + 1, sizeof(Type)));
+            new (Data() + size) Type(item);
+        }
+        else {
+            new (Data() + size) Type(std::forward<Args>(args)...);
+        }
+        GetHeader().size = size + 1;
+        return Data()[size];
+    }
+
+    // Непустой вектор теряет последний элемент. У перемещённого вектора ничего не делает
+    void PopBack() noexcept {
+        if (mapping_ == nullptr) {
+            return;
+        }
+        assert(!IsEmpty());
+        --GetHeader().size;
+    }
+
+    // Увеличивает файл так, чтобы в нём помещалось new_capacity элементов
+    void Reserve(size_t new_capacity) {
+        RequireMapping();
+        if (new_capacity > GetCapacity()) {
+            Remap(new_capacity);
+        }
+    }
+
+    // Синхронно записывает изменённые страницы и заголовок на диск (msync)
+    void Flush() {
+        if (mapping_ == nullptr) {
+            return;
+        }
+        if (::msync(mapping_, mapped_bytes_, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+    // Сообщает ядру, как будут читаться элементы: последовательно, вразнобой или скоро целиком
+    void Advise(MmapAdvice advice) {
+        if (mapping_ == nullptr) {
+            return;
+        }
+        int flag = MADV_NORMAL;
+        switch (advice) {
+        case MmapAdvice::kNormal:
+            flag = MADV_NORMAL;
+            break;
+        case MmapAdvice::kSequential:
+            flag = MADV_SEQUENTIAL;
+            break;
+        case MmapAdvice::kRandom:
+            flag = MADV_RANDOM;
+            break;
+        case MmapAdvice::kWillNeed:
+            flag = MADV_WILLNEED;
+            break;
+        }
+        if (::madvise(mapping_, mapped_bytes_, flag) != 0) {
+            throw std::system_error(errno, std::generic_category(), "madvise");
+        }
+    }
+
+private:
+    // Заголовок занимает 64 байта в начале файла, элементы идут сразу за ним
+    struct Header {
+        uint64_t magic;
+        uint64_t element_size;
+        uint64_t size;
+        uint64_t reserved[5];
+    };
+    static_assert(sizeof(Header) == 64);
+
+    static constexpr size_t kHeaderSize = sizeof(Header);
+    static constexpr uint64_t kMagic = 0x31564d4d56504d53;  // "SMPVMMV1"
+    // Вместимость нового файла
+    static constexpr size_t kInitialCapacity = 16;
+
+    int fd_ = -1;
+    void* mapping_ = nullptr;
+    size_t mapped_bytes_ = 0;
+
+    Header& GetHeader() noexcept {
+        return *static_cast<Header*>(mapping_);
+    }
+
+    const Header& GetHeader() const noexcept {
+        return *static_cast<const Header*>(mapping_);
+    }
+
+    // У перемещённого вектора — nullptr, поэтому begin() == end()
+    Type* Data() noexcept {
+        return mapping_ != nullptr ? reinterpret_cast<Type*>(static_cast<unsigned char*>(mapping_) + kHeaderSize) : nullptr;
+    }
+
+    const Type* Data() const noexcept {
+        return mapping_ != nullptr ? reinterpret_cast<const Type*>(static_cast<const unsigned char*>(mapping_) + kHeaderSize) : nullptr;
+    }
+
+    // Операции, которым нужен файл, недопустимы у перемещённого вектора
+    void RequireMapping() const {
+        if (mapping_ == nullptr) {
+            throw std::logic_error("MmapSimpleVector is not attached to a file");
+        }
+    }
+
+    void Open() {
+        struct stat info {};
+        if (::fstat(fd_, &info) != 0) {
+            throw std::system_error(errno, std::generic_category(), "fstat");
+        }
+        const size_t file_bytes = static_cast<size_t>(info.st_size);
+        if (file_bytes == 0) {
+            Truncate(BytesFor(kInitialCapacity));
+            Map(BytesFor(kInitialCapacity));
+            GetHeader() = Header{ kMagic, sizeof(Type), 0, {} };
+            return;
+        }
+        if (file_bytes < kHeaderSize) {
+            throw std::runtime_error("file is too small to hold a MmapSimpleVector header");
+        }
+        Map(file_bytes);
+        const Header& header = GetHeader();
+        if (header.magic != kMagic || header.element_size != sizeof(Type) || header.size > GetCapacity()) {
+            throw std::runtime_error("file does not hold a MmapSimpleVector of this element type");
+        }
+    }
+
+    static size_t BytesFor(size_t capacity) {
+        if (capacity > (SIZE_MAX - kHeaderSize) / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return kHeaderSize + capacity * sizeof(Type);
+    }
+
+    void Truncate(size_t bytes) {
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+        }
+    }
+
+    void Map(size_t bytes) {
+        void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        mapping_ = mapping;
+        mapped_bytes_ = bytes;
+    }
+
+    // Увеличивает файл и отображение до new_capacity элементов. Адрес отображения может измениться
+    void Remap(size_t new_capacity) {
+        const size_t bytes = BytesFor(new_capacity);
+        Truncate(bytes);
+#if defined(__linux__)
+        void* mapping = ::mremap(mapping_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+        if (mapping == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mremap");
+        }
+        mapping_ = mapping;
+        mapped_bytes_ = bytes;
+#else
+        // Все изменения уже в общем отображении файла, поэтому его можно просто открыть заново
+        void* old_mapping = mapping_;
+        const size_t old_bytes = mapped_bytes_;
+        Map(bytes);
+        ::munmap(old_mapping, old_bytes);
+#endif
+    }
+
+    void Close() noexcept {
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, mapped_bytes_);
+            mapping_ = nullptr;
+            mapped_bytes_ = 0;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+};
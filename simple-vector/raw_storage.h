@@ -0,0 +1,223 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Тип считается тривиально перемещаемым, если перенос объекта в другую память можно выполнить
+// побайтовым копированием, не вызывая конструктор перемещения и деструктор исходного объекта.
+// По умолчанию это верно для тривиально копируемых типов. Типы, которые не являются тривиально копируемыми,
+// но допускают такой перенос (например, владеющие указателем на кучу), могут специализировать трейт
+template <typename Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {};
+
+// RawStorage — родственник ArrayPtr, владеющий неинициализированной памятью под capacity элементов типа Type.
+// В отличие от ArrayPtr, не вызывает ни конструкторов, ни деструкторов элементов:
+// за создание и разрушение объектов в этой памяти отвечает владелец (например, SimpleVector).
+// Память берётся из аллокатора Alloc (стандартного, пулового, std::pmr::polymorphic_allocator и т.п.)
+template <typename Type, typename Alloc = std::allocator<Type>>
+class RawStorage {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    static_assert(std::is_same_v<typename AllocTraits::value_type, Type>, "Alloc::value_type must be Type");
+
+public:
+    using allocator_type = Alloc;
+
+    // Для std::allocator и типов с обычным выравниванием память берётся напрямую из malloc,
+    // что позволяет расширять её через realloc. Остальные аллокаторы используются как есть
+    static constexpr bool kCanReallocate = std::is_same_v<Alloc, std::allocator<Type>> && alignof(Type) <= alignof(std::max_align_t);
+
+    // Инициализирует RawStorage нулевым указателем и нулевой вместимостью
+    RawStorage() noexcept(noexcept(Alloc()))
+        : impl_(Alloc())
+    {}
+
+    explicit RawStorage(const Alloc& alloc) noexcept
+        : impl_(alloc)
+    {}
+
+    // Выделяет выровненную память под capacity элементов, не создавая их.
+    // Если capacity == 0, память не выделяется и указатель остаётся нулевым
+    explicit RawStorage(size_t capacity, const Alloc& alloc = Alloc())
+        : impl_(alloc)
+    {
+        impl_.buffer = Allocate(capacity);
+        impl_.capacity = capacity;
+    }
+
+    // Забирает во владение память buffer под capacity элементов, ранее отданную методом Release
+    RawStorage(Type* buffer, size_t capacity, const Alloc& alloc = Alloc()) noexcept
+        : impl_(alloc)
+    {
+        impl_.buffer = buffer;
+        impl_.capacity = capacity;
+    }
+
+    // Запрещаем копирование
+    RawStorage(const RawStorage&) = delete;
+    RawStorage& operator=(const RawStorage&) = delete;
+
+    // Перемещение забирает память вместе с аллокатором, которым она была выделена
+    RawStorage(RawStorage&& other) noexcept
+        : impl_(other.GetAllocatorRef())
+    {
+        impl_.buffer = std::exchange(other.impl_.buffer, nullptr);
+        impl_.capacity = std::exchange(other.impl_.capacity, 0);
+    }
+
+    // Память rhs можно забрать, только если аллокатор распространяется при перемещении
+    // либо аллокаторы равны. Иначе элементы должен перенести владелец
+    RawStorage& operator=(RawStorage&& rhs) noexcept {
+        if (this != &rhs) {
+            Deallocate(impl_.buffer, impl_.capacity);
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                GetAllocatorRef() = rhs.GetAllocatorRef();
+            }
+            else {
+                assert(GetAllocatorRef() == rhs.GetAllocatorRef());
+            }
+            impl_.buffer = std::exchange(rhs.impl_.buffer, nullptr);
+            impl_.capacity = std::exchange(rhs.impl_.capacity, 0);
+        }
+        return *this;
+    }
+
+    // Освобождает память. Элементы к этому моменту должны быть уже разрушены владельцем
+    ~RawStorage() {
+        Deallocate(impl_.buffer, impl_.capacity);
+    }
+
+    // Возвращает адрес ячейки с индексом offset. Разрешено получать адрес ячейки, следующей за последней
+    Type* operator+(size_t offset) noexcept {
+        return impl_.buffer + offset;
+    }
+
+    const Type* operator+(size_t offset) const noexcept {
+        return impl_.buffer + offset;
+    }
+
+    // Возвращает ссылку на элемент с индексом index. Элемент должен быть предварительно создан
+    Type& operator[](size_t index) noexcept {
+        return impl_.buffer[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return impl_.buffer[index];
+    }
+
+    // Возвращает значение сырого указателя на начало памяти
+    Type* Get() const noexcept {
+        return impl_.buffer;
+    }
+
+    // Как и ArrayPtr::Release, прекращает владение памятью и возвращает её адрес.
+    // Вернуть память можно только конструктором RawStorage(buffer, capacity) с равным аллокатором
+    [[nodiscard]] Type* Release() noexcept {
+        impl_.capacity = 0;
+        return std::exchange(impl_.buffer, nullptr);
+    }
+
+    // Возвращает количество ячеек, под которые выделена память
+    size_t GetCapacity() const noexcept {
+        return impl_.capacity;
+    }
+
+    // Возвращает копию аллокатора, которым выделяется память
+    Alloc GetAllocator() const noexcept {
+        return GetAllocatorRef();
+    }
+
+    // Изменяет вместимость при помощи realloc, сохраняя первые min(capacity, new_capacity) ячеек побайтово.
+    // Допустимо только для тривиально перемещаемых типов. Для больших блоков realloc
+    // обычно переотображает страницы (mremap) и вовсе не копирует данные.
+    // При нехватке памяти выбрасывает std::bad_alloc, оставляя хранилище нетронутым
+    void Reallocate(size_t new_capacity) {
+        static_assert(kCanReallocate, "Reallocate requires std::allocator and default-aligned Type");
+        static_assert(IsTriviallyRelocatable<Type>::value, "Reallocate requires trivially relocatable Type");
+        if (new_capacity == 0) {
+            Deallocate(impl_.buffer, impl_.capacity);
+            impl_.buffer = nullptr;
+            impl_.capacity = 0;
+            return;
+        }
+        if (new_capacity > SIZE_MAX / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        void* new_buffer = std::realloc(static_cast<void*>(impl_.buffer), new_capacity * sizeof(Type));
+        if (new_buffer == nullptr) {
+            throw std::bad_alloc();
+        }
+        impl_.buffer = static_cast<Type*>(new_buffer);
+        impl_.capacity = new_capacity;
+    }
+
+    // Обменивается памятью с объектом other. Аллокаторы обмениваются, если этого требует
+    // propagate_on_container_swap, иначе они должны быть равны
+    void swap(RawStorage& other) noexcept {
+        using std::swap;
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            swap(GetAllocatorRef(), other.GetAllocatorRef());
+        }
+        else {
+            assert(GetAllocatorRef() == other.GetAllocatorRef());
+        }
+        swap(impl_.buffer, other.impl_.buffer);
+        swap(impl_.capacity, other.impl_.capacity);
+    }
+
+private:
+    // Аллокатор хранится базой, чтобы пустые аллокаторы вроде std::allocator не занимали места
+    struct Impl : Alloc {
+        explicit Impl(const Alloc& alloc) noexcept
+            : Alloc(alloc)
+        {}
+
+        Type* buffer = nullptr;
+        size_t capacity = 0;
+    };
+
+    Impl impl_;
+
+    Alloc& GetAllocatorRef() noexcept {
+        return impl_;
+    }
+
+    const Alloc& GetAllocatorRef() const noexcept {
+        return impl_;
+    }
+
+    Type* Allocate(size_t capacity) {
+        if (capacity == 0) {
+            return nullptr;
+        }
+        if (capacity > SIZE_MAX / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        if constexpr (kCanReallocate) {
+            void* buffer = std::malloc(capacity * sizeof(Type));
+            if (buffer == nullptr) {
+                throw std::bad_alloc();
+            }
+            return static_cast<Type*>(buffer);
+        }
+        else {
+            return AllocTraits::allocate(GetAllocatorRef(), capacity);
+        }
+    }
+
+    void Deallocate(Type* buffer, size_t capacity) noexcept {
+        if (buffer == nullptr) {
+            return;
+        }
+        if constexpr (kCanReallocate) {
+            std::free(buffer);
+        }
+        else {
+            AllocTraits::deallocate(GetAllocatorRef(), buffer, capacity);
+        }
+    }
+};
@@ -0,0 +1,481 @@
+#pragma once
+
+#include "raw_storage.h"
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+
+// Блок по умолчанию занимает около 4 КБ, но вмещает не меньше 16 элементов
+template <typename Type>
+constexpr size_t DefaultSegmentBlockSize() noexcept {
+    size_t block_size = 16;
+    while (block_size * sizeof(Type) < 4096) {
+        block_size *= 2;
+    }
+    return block_size;
+}
+
+} // namespace detail
+
+// SegmentedSimpleVector — последовательность элементов в блоках фиксированного размера BlockSize, как std::deque,
+// но только с добавлением в конец. Переполнение не переносит элементы: выделяется ещё один блок,
+// поэтому PushBack не вызывает всплесков задержки и пиков памяти, а ссылки и указатели на элементы
+// остаются действительными до их удаления. Растёт лишь таблица указателей на блоки — один указатель на BlockSize элементов;
+// после Reserve растить её не нужно, и PushBack выполняется за O(1) в худшем случае.
+// BlockSize — степень двойки, так что индекс раскладывается на номер блока и смещение сдвигом и маской.
+// Итераторы указывают в таблицу блоков и становятся недействительными при её росте
+template <typename Type, size_t BlockSize = detail::DefaultSegmentBlockSize<Type>()>
+class SegmentedSimpleVector {
+    static_assert(BlockSize > 0 && (BlockSize & (BlockSize - 1)) == 0, "BlockSize must be a power of two");
+
+    static constexpr size_t kBlockShift = [] {
+        size_t shift = 0;
+        while ((size_t(1) << shift) != BlockSize) {
+            ++shift;
+        }
+        return shift;
+    }();
+    static constexpr size_t kBlockMask = BlockSize - 1;
+
+public:
+    template <bool IsConst>
+    class BlockIterator {
+        using Block = std::conditional_t<IsConst, const Type*, Type*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+
+        BlockIterator() noexcept = default;
+
+        BlockIterator(const Block* blocks, size_t index) noexcept
+            : blocks_(blocks)
+            , index_(index)
+        {}
+
+        // Изменяемый итератор неявно превращается в константный
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BlockIterator(const BlockIterator<OtherConst>& other) noexcept
+            : blocks_(other.blocks_)
+            , index_(other.index_)
+        {}
+
+        reference operator*() const noexcept {
+            return blocks_[index_ >> kBlockShift][index_ & kBlockMask];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BlockIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BlockIterator operator++(int) noexcept {
+            BlockIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        BlockIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BlockIterator operator--(int) noexcept {
+            BlockIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        BlockIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BlockIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BlockIterator operator+(BlockIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BlockIterator operator+(difference_type offset, BlockIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BlockIterator operator-(BlockIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BlockIterator& lhs, const BlockIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BlockIterator& lhs, const BlockIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BlockIterator& lhs, const BlockIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BlockIterator& lhs, const BlockIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BlockIterator& lhs, const BlockIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BlockIterator& lhs, const BlockIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BlockIterator& lhs, const BlockIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        template <bool>
+        friend class BlockIterator;
+
+        const Block* blocks_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using Iterator = BlockIterator<false>;
+    using ConstIterator = BlockIterator<true>;
+
+    static constexpr size_t kBlockSize = BlockSize;
+
+    SegmentedSimpleVector() noexcept = default;
+
+    // Конструкторы делегируют конструктору по умолчанию: если они выбросят исключение,
+    // деструктор разрушит уже созданные элементы и освободит блоки
+    explicit SegmentedSimpleVector(size_t size)
+        : SegmentedSimpleVector()
+    {
+        Resize(size);
+    }
+
+    SegmentedSimpleVector(size_t size, const Type& value)
+        : SegmentedSimpleVector()
+    {
+        Reserve(size);
+        while (size_ < size) {
+            PushBack(value);
+        }
+    }
+
+    SegmentedSimpleVector(std::initializer_list<Type> init)
+        : SegmentedSimpleVector()
+    {
+        Reserve(init.size());
+        for (const Type& item : init) {
+            PushBack(item);
+        }
+    }
+
+    SegmentedSimpleVector(ReserveProxyObj obj)
+        : SegmentedSimpleVector()
+    {
+        Reserve(obj.capacity_to_reserve_);
+    }
+
+    SegmentedSimpleVector(const SegmentedSimpleVector& other)
+        : SegmentedSimpleVector()
+    {
+        Reserve(other.size_);
+        other.ForEachBlock([this](const Type* items, size_t count) {
+            // Блоки обоих векторов одного размера, поэтому блок копируется целиком в блок с тем же номером
+            detail::UninitializedCopy(items, items + count, blocks_[size_ >> kBlockShift]);
+            size_ += count;
+        });
+    }
+
+    SegmentedSimpleVector(SegmentedSimpleVector&& other) noexcept
+        : blocks_(std::move(other.blocks_))
+        , size_(std::exchange(other.size_, 0))
+    {}
+
+    ~SegmentedSimpleVector() {
+        Reset();
+    }
+
+    SegmentedSimpleVector& operator=(const SegmentedSimpleVector& rhs) {
+        if (this != &rhs) {
+            SegmentedSimpleVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    SegmentedSimpleVector& operator=(SegmentedSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            SegmentedSimpleVector temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return blocks_.GetSize() * BlockSize;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return blocks_[index >> kBlockShift][index & kBlockMask];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return blocks_[index >> kBlockShift][index & kBlockMask];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("index > size_");
+        }
+        return (*this)[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index > size_");
+        }
+        return (*this)[index];
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(blocks_.Data(), 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(blocks_.Data(), size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(blocks_.Data(), 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(blocks_.Data(), size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Разрушает элементы, оставляя блоки выделенными
+    void Clear() noexcept {
+        ForEachBlock([](Type* items, size_t count) {
+            std::destroy_n(items, count);
+        });
+        size_ = 0;
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            while (size_ > new_size) {
+                PopBack();
+            }
+            return;
+        }
+        Reserve(new_size);
+        while (size_ < new_size) {
+            EmplaceBack();
+        }
+    }
+
+    // Выделяет блоки под new_capacity элементов и таблицу под них, после чего
+    // добавление до new_capacity элементов не выделяет память
+    void Reserve(size_t new_capacity) {
+        const size_t block_count = (new_capacity + kBlockMask) >> kBlockShift;
+        blocks_.Reserve(block_count);
+        while (blocks_.GetSize() < block_count) {
+            AddBlock();
+        }
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Элементы не перемещаются, поэтому аргумент может ссылаться на элемент этого же вектора
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            AddBlock();
+        }
+        Type* slot = blocks_[size_ >> kBlockShift] + (size_ & kBlockMask);
+        new (slot) Type(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        std::destroy_at(blocks_[size_ >> kBlockShift] + (size_ & kBlockMask));
+    }
+
+    // Освобождает блоки за последним занятым
+    void ShrinkToFit() noexcept {
+        const size_t used_blocks = (size_ + kBlockMask) >> kBlockShift;
+        while (blocks_.GetSize() > used_blocks) {
+            FreeBlock(blocks_[blocks_.GetSize() - 1]);
+            blocks_.PopBack();
+        }
+    }
+
+    // Разрушает элементы и освобождает все блоки
+    void Reset() noexcept {
+        Clear();
+        ShrinkToFit();
+        blocks_.Reset();
+    }
+
+    void swap(SegmentedSimpleVector& other) noexcept {
+        blocks_.swap(other.blocks_);
+        std::swap(size_, other.size_);
+    }
+
+    // Переносит элементы в непрерывный SimpleVector, оставляя этот вектор пустым. Блоки освобождаются.
+    // Тривиально перемещаемые элементы переносятся memcpy по блоку за раз
+    SimpleVector<Type> Flatten() {
+        SimpleVector<Type> result;
+        result.Reserve(size_);
+        result.AppendConstructed(size_, [this](Type* dest) {
+            size_t done = 0;
+            if constexpr (IsTriviallyRelocatable<Type>::value) {
+                ForEachBlock([&](Type* items, size_t count) {
+                    detail::RelocateBytes(items, count, dest + done);
+                    done += count;
+                });
+                size_ = 0;
+            }
+            else {
+                // Исключение при переносе оставляет этот вектор нетронутым, перенесённые копии разрушаются
+                try {
+                    ForEachBlock([&](Type* items, size_t count) {
+                        detail::UninitializedMoveIfNoexcept(items, items + count, dest + done);
+                        done += count;
+                    });
+                }
+                catch (...) {
+                    std::destroy_n(dest, done);
+                    throw;
+                }
+            }
+        });
+        Reset();
+        return result;
+    }
+
+    // Копирует элементы в непрерывный SimpleVector
+    SimpleVector<Type> ToSimpleVector() const {
+        SimpleVector<Type> result;
+        result.Reserve(size_);
+        ForEachBlock([&result](const Type* items, size_t count) {
+            result.Append(items, items + count);
+        });
+        return result;
+    }
+
+private:
+    SimpleVector<Type*> blocks_;
+    size_t size_ = 0;
+
+    // Блок выделяется до добавления в таблицу: если таблица не вырастет, память вернёт RawStorage
+    void AddBlock() {
+        RawStorage<Type> block(BlockSize);
+        blocks_.PushBack(block.Get());
+        static_cast<void>(block.Release());
+    }
+
+    static void FreeBlock(Type* block) noexcept {
+        // Память возвращается в RawStorage, который её и выделил
+        RawStorage<Type> storage(block, BlockSize);
+    }
+
+    // Вызывает func(items, count) для заполненной части каждого блока по порядку
+    template <typename Func>
+    void ForEachBlock(Func func) const {
+        size_t remaining = size_;
+        for (size_t block = 0; remaining != 0; ++block) {
+            const size_t count = std::min(remaining, BlockSize);
+            func(blocks_[block], count);
+            remaining -= count;
+        }
+    }
+};
+
+template <typename Type, size_t BlockSize>
+bool operator==(const SegmentedSimpleVector<Type, BlockSize>& lhs, const SegmentedSimpleVector<Type, BlockSize>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, size_t BlockSize>
+bool operator!=(const SegmentedSimpleVector<Type, BlockSize>& lhs, const SegmentedSimpleVector<Type, BlockSize>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t BlockSize>
+bool operator<(const SegmentedSimpleVector<Type, BlockSize>& lhs, const SegmentedSimpleVector<Type, BlockSize>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t BlockSize>
+bool operator<=(const SegmentedSimpleVector<Type, BlockSize>& lhs, const SegmentedSimpleVector<Type, BlockSize>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t BlockSize>
+bool operator>(const SegmentedSimpleVector<Type, BlockSize>& lhs, const SegmentedSimpleVector<Type, BlockSize>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t BlockSize>
+bool operator>=(const SegmentedSimpleVector<Type, BlockSize>& lhs, const SegmentedSimpleVector<Type, BlockSize>& rhs) {
+    return !(lhs < rhs);
+}
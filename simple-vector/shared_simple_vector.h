@@ -0,0 +1,304 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+// SharedSimpleVector — SimpleVector с копированием при записи. Копии разделяют один блок элементов
+// со счётчиком ссылок, поэтому копирование и присваивание стоят O(1). Первая изменяющая операция над
+// разделяемым блоком (неконстантные operator[], At, begin, PushBack, Insert, Erase и т.д.) создаёт собственную копию.
+//
+// Разные объекты SharedSimpleVector, разделяющие блок, можно читать и изменять из разных потоков.
+// Один и тот же объект, как и SimpleVector, требует внешней синхронизации.
+// Неконстантные ссылки и итераторы действительны до следующего копирования этого объекта: после него блок
+// снова становится разделяемым, и запись через старые ссылки была бы видна копиям
+template <typename Type>
+class SharedSimpleVector {
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Пустой вектор не выделяет ни блока, ни памяти под элементы
+    SharedSimpleVector() noexcept = default;
+
+    explicit SharedSimpleVector(size_t size)
+        : items_(BlockPtr::Make(size))
+    {}
+
+    SharedSimpleVector(size_t size, const Type& value)
+        : items_(BlockPtr::Make(size, value))
+    {}
+
+    SharedSimpleVector(std::initializer_list<Type> init)
+        : items_(BlockPtr::Make(init))
+    {}
+
+    // Забирает элементы обычного вектора без копирования
+    explicit SharedSimpleVector(SimpleVector<Type>&& items)
+        : items_(BlockPtr::Make(std::move(items)))
+    {}
+
+    size_t GetSize() const noexcept {
+        return items_ ? items_->GetSize() : 0;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return items_ ? items_->GetCapacity() : 0;
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Сообщает, разделяет ли этот вектор блок с другими
+    bool IsShared() const noexcept {
+        return items_ && !items_.IsSoleOwner();
+    }
+
+    // Содержимое как обычный вектор только для чтения. Блок при этом не копируется
+    const SimpleVector<Type>& Get() const noexcept {
+        return items_ ? *items_ : kEmpty;
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return (*items_)[index];
+    }
+
+    Type& operator[](size_t index) {
+        assert(index < GetSize());
+        return Mutable()[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        return Get().At(index);
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("index > size_");
+        }
+        return Mutable()[index];
+    }
+
+    ConstIterator begin() const noexcept {
+        return Get().Data();
+    }
+
+    ConstIterator end() const noexcept {
+        return Get().Data() + Get().GetSize();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    Iterator begin() {
+        return Mutable().Data();
+    }
+
+    Iterator end() {
+        SimpleVector<Type>& items = Mutable();
+        return items.Data() + items.GetSize();
+    }
+
+    // Разделяемый блок не копируется: этот вектор просто отказывается от него
+    void Clear() noexcept {
+        if (IsShared()) {
+            items_.Reset();
+        }
+        else if (items_) {
+            items_->Clear();
+        }
+    }
+
+    void Resize(size_t new_size) {
+        Mutable().Resize(new_size);
+    }
+
+    void Reserve(size_t new_capacity) {
+        Mutable().Reserve(new_capacity);
+    }
+
+    void PushBack(const Type& item) {
+        Mutable().PushBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        Mutable().PushBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return Mutable().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // pos может указывать в разделяемый блок: после отделения он пересчитывается в собственную копию
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        const size_t index = pos - Get().Data();
+        SimpleVector<Type>& items = Mutable();
+        items.Emplace(items.begin() + index, std::forward<Args>(args)...);
+        return items.Data() + index;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        const size_t index = pos - Get().Data();
+        SimpleVector<Type>& items = Mutable();
+        items.Erase(items.begin() + index);
+        return items.Data() + index;
+    }
+
+    void PopBack() {
+        assert(!IsEmpty());
+        Mutable().PopBack();
+    }
+
+    void swap(SharedSimpleVector& other) noexcept {
+        items_.swap(other.items_);
+    }
+
+private:
+    static inline const SimpleVector<Type> kEmpty{};
+
+    // Блок элементов со своим счётчиком владельцев. shared_ptr не подходит: его use_count читается
+    // без упорядочивания, и решение писать в блок на месте не было бы синхронизировано с чтениями
+    // владельцев, которые только что отказались от блока в других потоках
+    struct Block {
+        template <typename... Args>
+        explicit Block(Args&&... args)
+            : items(std::forward<Args>(args)...)
+        {}
+
+        std::atomic<size_t> owners{ 1 };
+        SimpleVector<Type> items;
+    };
+
+    // Владеющий указатель на Block с подсчётом ссылок
+    class BlockPtr {
+    public:
+        BlockPtr() noexcept = default;
+
+        template <typename... Args>
+        static BlockPtr Make(Args&&... args) {
+            BlockPtr ptr;
+            ptr.block_ = new Block(std::forward<Args>(args)...);
+            return ptr;
+        }
+
+        BlockPtr(const BlockPtr& other) noexcept
+            : block_(other.block_)
+        {
+            if (block_ != nullptr) {
+                block_->owners.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        BlockPtr(BlockPtr&& other) noexcept
+            : block_(std::exchange(other.block_, nullptr))
+        {}
+
+        BlockPtr& operator=(BlockPtr rhs) noexcept {
+            swap(rhs);
+            return *this;
+        }
+
+        ~BlockPtr() {
+            Reset();
+        }
+
+        // Отказывается от блока. Уменьшение счётчика с release публикует все чтения и записи этого владельца
+        // тому, кто затем увидит себя единственным владельцем
+        void Reset() noexcept {
+            if (block_ != nullptr && block_->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete block_;
+            }
+            block_ = nullptr;
+        }
+
+        void swap(BlockPtr& other) noexcept {
+            std::swap(block_, other.block_);
+        }
+
+        // Других владельцев нет. Счётчик тогда не может вырасти без участия этого владельца, а чтение с acquire
+        // упорядочивает всё, что бывшие владельцы сделали с блоком, перед последующими записями в него
+        bool IsSoleOwner() const noexcept {
+            return block_->owners.load(std::memory_order_acquire) == 1;
+        }
+
+        explicit operator bool() const noexcept {
+            return block_ != nullptr;
+        }
+
+        SimpleVector<Type>& operator*() const noexcept {
+            return block_->items;
+        }
+
+        SimpleVector<Type>* operator->() const noexcept {
+            return &block_->items;
+        }
+
+    private:
+        Block* block_ = nullptr;
+    };
+
+    BlockPtr items_;
+
+    // Возвращает собственный блок, копируя разделяемый
+    SimpleVector<Type>& Mutable() {
+        if (!items_) {
+            items_ = BlockPtr::Make();
+        }
+        else if (!items_.IsSoleOwner()) {
+            items_ = BlockPtr::Make(*items_);
+        }
+        return *items_;
+    }
+};
+
+template <typename Type>
+bool operator==(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return lhs.Get() == rhs.Get();
+}
+
+template <typename Type>
+bool operator!=(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type>
+bool operator<(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return lhs.Get() < rhs.Get();
+}
+
+template <typename Type>
+bool operator<=(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type>
+bool operator>(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type>
+bool operator>=(const SharedSimpleVector<Type>& lhs, const SharedSimpleVector<Type>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define SIMPLE_VECTOR_SIMD_X86 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SIMPLE_VECTOR_SIMD_NEON 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace detail {
+
+// Номер младшего установленного бита. mask не должна быть нулевой
+inline unsigned CountTrailingZeros(uint32_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Возвращает смещение первого байта, в котором lhs и rhs различаются, либо size, если различий нет.
+// Сравнивает по 32 (AVX2) или 16 (SSE2, NEON) байт за шаг, хвост — побайтово
+inline size_t FindFirstMismatchingByte(const void* lhs_ptr, const void* rhs_ptr, size_t size) noexcept {
+    const auto* lhs = static_cast<const unsigned char*>(lhs_ptr);
+    const auto* rhs = static_cast<const unsigned char*>(rhs_ptr);
+    size_t offset = 0;
+#if defined(__AVX2__)
+    for (; offset + 32 <= size; offset += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + offset));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + offset));
+        const uint32_t equal = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+        if (equal != 0xFFFFFFFFu) {
+            return offset + CountTrailingZeros(~equal);
+        }
+    }
+#endif
+#if defined(SIMPLE_VECTOR_SIMD_X86)
+    for (; offset + 16 <= size; offset += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + offset));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + offset));
+        const uint32_t equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+        if (equal != 0xFFFFu) {
+            return offset + CountTrailingZeros(~equal & 0xFFFFu);
+        }
+    }
+#elif defined(SIMPLE_VECTOR_SIMD_NEON)
+    for (; offset + 16 <= size; offset += 16) {
+        const uint8x16_t equal = vceqq_u8(vld1q_u8(lhs + offset), vld1q_u8(rhs + offset));
+        if (vminvq_u8(equal) != 0xFF) {
+            // Различие есть внутри блока: находим его побайтово
+            break;
+        }
+    }
+#endif
+    for (; offset < size; ++offset) {
+        if (lhs[offset] != rhs[offset]) {
+            return offset;
+        }
+    }
+    return size;
+}
+
+} // namespace detail
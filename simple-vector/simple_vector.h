@@ -1,7 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include "byte_hash.h"
+#include <cstring>
+#include <functional>
+#include "growth_policy.h"
 #include <initializer_list>
-#include "array_ptr.h" 
+#include <iterator>
+#include <memory>
+#include <new>
+#include "raw_storage.h"
+#include "simd_compare.h"
+#include "simple_vector_debug.h"
+#include "stats_policy.h"
 #include <stdexcept>
 #include <utility>
 
@@ -18,61 +30,341 @@ public:
     size_t capacity_to_reserve_;
 };
 
+// Общие для SimpleVector и родственных контейнеров операции над неинициализированной памятью
+namespace detail {
+
+// Новый элемент временно создаётся на стеке только для небольших тривиально перемещаемых типов
+template <typename Type>
+inline constexpr bool kRelocateThroughStack = IsTriviallyRelocatable<Type>::value && sizeof(Type) <= 256;
+
+template <typename Type>
+void RelocateBytes(const Type* from, size_t count, Type* to) noexcept {
+    if (count != 0) {
+        std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(Type));
+    }
+}
+
+template <typename Type>
+void MoveBytes(const Type* from, size_t count, Type* to) noexcept {
+    if (count != 0) {
+        std::memmove(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(Type));
+    }
+}
+
+// Элементы переносятся в новую память перемещением, если оно не выбрасывает исключений или копирование невозможно,
+// и копированием иначе, как в std::move_if_noexcept. Тогда исключение при переносе оставляет исходные элементы нетронутыми
+template <typename Type>
+inline constexpr bool kMoveOnRelocate = std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>;
+
+// Перемещает или копирует [first, last) в неинициализированную память to по правилу kMoveOnRelocate.
+// Если создание элемента выбросило исключение, созданные элементы разрушаются
+template <typename Type>
+Type* UninitializedMoveIfNoexcept(Type* first, Type* last, Type* to) {
+    if constexpr (kMoveOnRelocate<Type>) {
+        return std::uninitialized_move(first, last, to);
+    }
+    else {
+        return std::uninitialized_copy(first, last, to);
+    }
+}
+
+// Переносит count элементов из from в неинициализированную память to. Исходные элементы разрушаются.
+// Если перенос выбросил исключение, исходные элементы остаются на месте (кроме типов, которые нельзя копировать
+// и перемещение которых может выбросить исключение)
+template <typename Type>
+void RelocateElements(Type* from, size_t count, Type* to) {
+    if constexpr (IsTriviallyRelocatable<Type>::value) {
+        RelocateBytes(from, count, to);
+    }
+    else {
+        UninitializedMoveIfNoexcept(from, from + count, to);
+        std::destroy_n(from, count);
+    }
+}
+
+// Переносит size элементов из from в to вокруг gap_size ячеек, начиная с gap, которые вызывающий код уже заполнил
+// новыми элементами. Если перенос выбросил исключение, новые элементы разрушаются, а исходные остаются на месте
+template <typename Type>
+void RelocateAroundGap(Type* from, size_t size, Type* to, size_t gap, size_t gap_size = 1) {
+    if constexpr (IsTriviallyRelocatable<Type>::value) {
+        RelocateBytes(from, gap, to);
+        RelocateBytes(from + gap, size - gap, to + gap + gap_size);
+    }
+    else {
+        try {
+            UninitializedMoveIfNoexcept(from, from + gap, to);
+            try {
+                UninitializedMoveIfNoexcept(from + gap, from + size, to + gap + gap_size);
+            }
+            catch (...) {
+                std::destroy_n(to, gap);
+                throw;
+            }
+        }
+        catch (...) {
+            std::destroy_n(to + gap, gap_size);
+            throw;
+        }
+        std::destroy_n(from, size);
+    }
+}
+
+template <typename It>
+using IteratorCategory = typename std::iterator_traits<It>::iterator_category;
+
+// Разрешает перегрузку только для итераторов, чтобы SimpleVector(first, last) не путался с SimpleVector(size, value)
+template <typename It>
+using RequireInputIterator = std::enable_if_t<std::is_convertible_v<IteratorCategory<It>, std::input_iterator_tag>>;
+
+template <typename It>
+inline constexpr bool kIsForwardIterator = std::is_convertible_v<IteratorCategory<It>, std::forward_iterator_tag>;
+
+// Копирует [first, last) в неинициализированную память to и возвращает конец скопированного.
+// Непрерывный диапазон тривиально копируемых элементов копируется одним memcpy
+template <typename It, typename Type>
+Type* UninitializedCopy(It first, It last, Type* to) {
+    if constexpr (std::is_pointer_v<It> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<It>>, Type>
+                  && std::is_trivially_copyable_v<Type>) {
+        const size_t count = last - first;
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(first), count * sizeof(Type));
+        }
+        return to + count;
+    }
+    else {
+        return std::uninitialized_copy(first, last, to);
+    }
+}
+
+// Создаёт элемент в позиции index < size, сдвигая хвост вправо. За size должна быть свободная ячейка
+template <typename Type, typename... Args>
+void EmplaceShifting(Type* data, size_t size, size_t index, Args&&... args) {
+    assert(index < size);
+    if constexpr (kRelocateThroughStack<Type>) {
+        // Хвост сдвигается одним memmove, а новый элемент переносится в освободившуюся ячейку побайтово
+        alignas(Type) unsigned char buffer[sizeof(Type)];
+        Type* value = new (buffer) Type(std::forward<Args>(args)...);
+        MoveBytes(data + index, size - index, data + index + 1);
+        RelocateBytes(value, 1, data + index);
+    }
+    else {
+        // Временный объект нужен на случай, если args ссылаются на элемент, который будет сдвинут
+        Type value(std::forward<Args>(args)...);
+        new (data + size) Type(std::move(data[size - 1]));
+        std::move_backward(data + index, data + size - 1, data + size);
+        data[index] = std::move(value);
+    }
+}
+
+// Удаляет элемент в позиции index < size, сдвигая хвост влево. Последняя ячейка остаётся неинициализированной
+template <typename Type>
+void EraseShifting(Type* data, size_t size, size_t index) {
+    assert(index < size);
+    if constexpr (IsTriviallyRelocatable<Type>::value) {
+        std::destroy_at(data + index);
+        MoveBytes(data + index + 1, size - index - 1, data + index);
+    }
+    else {
+        std::move(data + index + 1, data + size, data + index);
+        std::destroy_at(data + size - 1);
+    }
+}
+
+// Удаляет count элементов, начиная с index, сдвигая хвост влево за один проход. Освободившиеся ячейки остаются неинициализированными
+template <typename Type>
+void EraseRangeShifting(Type* data, size_t size, size_t index, size_t count) {
+    assert(index + count <= size);
+    if constexpr (IsTriviallyRelocatable<Type>::value) {
+        std::destroy_n(data + index, count);
+        MoveBytes(data + index + count, size - index - count, data + index);
+    }
+    else {
+        std::move(data + index + count, data + size, data + index);
+        std::destroy(data + size - count, data + size);
+    }
+}
+
+// Удаляет элементы, для которых pred возвращает true, сохраняя порядок остальных. Возвращает количество оставшихся
+template <typename Type, typename Predicate>
+size_t RemoveIfCompacting(Type* data, size_t size, Predicate pred) {
+    Type* new_end = std::remove_if(data, data + size, pred);
+    std::destroy(new_end, data + size);
+    return new_end - data;
+}
+
+// Переносит последний элемент на место удаляемого в позиции index < size
+template <typename Type>
+void SwapRemoveLast(Type* data, size_t size, size_t index) {
+    assert(index < size);
+    if constexpr (IsTriviallyRelocatable<Type>::value) {
+        std::destroy_at(data + index);
+        MoveBytes(data + size - 1, 1, data + index);
+    }
+    else {
+        if (index != size - 1) {
+            data[index] = std::move(data[size - 1]);
+        }
+        std::destroy_at(data + size - 1);
+    }
+}
+
+// Для целых, перечислений и указателей равенство значений совпадает с равенством байтов
+template <typename Type>
+inline constexpr bool kBytewiseEqual = std::is_integral_v<Type> || std::is_enum_v<Type> || std::is_pointer_v<Type>;
+
+// Беззнаковые однобайтовые значения упорядочены так же, как их байты в memcmp
+template <typename Type>
+inline constexpr bool kBytewiseOrdered = std::is_integral_v<Type> && std::is_unsigned_v<Type> && sizeof(Type) == 1;
+
+template <typename Type>
+bool RangesEqual(const Type* lhs, size_t lhs_size, const Type* rhs, size_t rhs_size) {
+    if (lhs_size != rhs_size) {
+        return false;
+    }
+    if constexpr (kBytewiseEqual<Type>) {
+        return lhs_size == 0 || std::memcmp(lhs, rhs, lhs_size * sizeof(Type)) == 0;
+    }
+    else {
+        return std::equal(lhs, lhs + lhs_size, rhs);
+    }
+}
+
 template <typename Type>
+bool RangesLess(const Type* lhs, size_t lhs_size, const Type* rhs, size_t rhs_size) {
+    const size_t common_size = std::min(lhs_size, rhs_size);
+    if constexpr (kBytewiseOrdered<Type>) {
+        const int order = common_size == 0 ? 0 : std::memcmp(lhs, rhs, common_size);
+        return order < 0 || (order == 0 && lhs_size < rhs_size);
+    }
+    else if constexpr (std::is_arithmetic_v<Type>) {
+        // Векторно ищем первый различающийся байт и сравниваем содержащие его элементы.
+        // Для чисел с плавающей точкой разные байты не всегда означают разные значения (0.0 и -0.0, NaN),
+        // поэтому несравнимые или равные элементы пропускаются, как в std::lexicographical_compare
+        size_t index = 0;
+        while (index < common_size) {
+            index += FindFirstMismatchingByte(lhs + index, rhs + index, (common_size - index) * sizeof(Type)) / sizeof(Type);
+            if (index == common_size) {
+                break;
+            }
+            if (lhs[index] < rhs[index]) {
+                return true;
+            }
+            if (rhs[index] < lhs[index]) {
+                return false;
+            }
+            ++index;
+        }
+        return lhs_size < rhs_size;
+    }
+    else {
+        return std::lexicographical_compare(lhs, lhs + lhs_size, rhs, rhs + rhs_size);
+    }
+}
+
+} // namespace detail
+
+// Память под элементы выделяется аллокатором Alloc. Это позволяет, например, брать короткоживущие векторы
+// из std::pmr::monotonic_buffer_resource и освобождать их все разом. Элементы создаются размещающим new.
+// GrowthPolicy определяет, до какой вместимости растёт заполненный вектор (см. growth_policy.h).
+// Stats получает уведомления о выделениях, переносах и копированиях (см. stats_policy.h). По умолчанию ничего не собирает
+template <typename Type, typename Alloc = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth, typename Stats = NoStats>
 class SimpleVector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
 public:
+#ifdef SIMPLE_VECTOR_DEBUG
+    // В отладочном режиме итераторы проверяют, что память вектора не перевыделялась (см. simple_vector_debug.h)
+    using Iterator = detail::CheckedIterator<Type, SimpleVector>;
+    using ConstIterator = detail::CheckedIterator<const Type, SimpleVector>;
+#else
     using Iterator = Type*;
     using ConstIterator = const Type*;
+#endif
+    using allocator_type = Alloc;
 
     // По умолчанию. Создаёт пустой вектор с нулевой вместимостью. Не выделяет динамическую память и не выбрасывает исключений.
-    SimpleVector() noexcept = default;
+    SimpleVector() noexcept(noexcept(Alloc())) = default;
+
+    // Создаёт пустой вектор, память для которого будет выделять alloc
+    explicit SimpleVector(const Alloc& alloc) noexcept
+        : items_(alloc)
+    {}
 
     // Создаёт вектор из size элементов, инициализированных значением по умолчанию
     // Параметризованный конструктор, создающий вектор заданного размера. 
     // Элементы вектора инициализированы значением по умолчанию для типа Type. 
     // Вектор должен иметь одинаковые размер и вместимость. 
     // Если размер нулевой, динамическая память для его элементов выделяться не должна.
-    explicit SimpleVector(size_t size)
-        : SimpleVector(size, Type())
-    {}
+    explicit SimpleVector(size_t size, const Alloc& alloc = Alloc())
+        : items_(AllocateStorage(size, alloc))
+    {
+        OnStorageChanged();
+        std::uninitialized_value_construct_n(items_.Get(), size);
+        size_ = size;
+    }
 
     // Создаёт вектор из size элементов, инициализированных значением value
-    SimpleVector(size_t size, const Type& value)
-        : items_(size)
-        , capacity_(size)
-        , size_(size)
+    SimpleVector(size_t size, const Type& value, const Alloc& alloc = Alloc())
+        : items_(AllocateStorage(size, alloc))
     {
-        std::fill(items_.Get(), items_.Get() + size_, value);
+        OnStorageChanged();
+        std::uninitialized_fill_n(items_.Get(), size, value);
+        size_ = size;
     }
 
     // Конструктор из std::initializer_list. Элементы вектора должны содержать копию элементов initializer_list. 
     // Имеет размер и вместимость, совпадающую с размерами и вместимостью переданного initializer_list.
-    SimpleVector(std::initializer_list<Type> init)
-        : items_(init.size())
-        , capacity_(init.size())
-        , size_(init.size())
+    SimpleVector(std::initializer_list<Type> init, const Alloc& alloc = Alloc())
+        : items_(AllocateStorage(init.size(), alloc))
     {
-        std::copy(init.begin(), init.end(), items_.Get());
+        OnStorageChanged();
+        std::uninitialized_copy(init.begin(), init.end(), items_.Get());
+        size_ = init.size();
+        Stats::OnCopy(size_, sizeof(Type));
+    }
+
+    // Создаёт вектор из копий элементов [first, last). Для forward-итераторов память выделяется ровно один раз
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    SimpleVector(InputIt first, InputIt last, const Alloc& alloc = Alloc())
+        : items_(alloc)
+    {
+        Assign(first, last);
     }
 
     // Конструктор копирования. Копия вектора должна иметь вместимость, достаточную для хранения копии элементов исходного вектора.
     SimpleVector(const SimpleVector& other)
-        : items_(other.size_)
-        , capacity_(other.size_)
-        , size_(other.size_)
+        : SimpleVector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {}
+
+    // Копирует элементы other, выделяя память аллокатором alloc
+    SimpleVector(const SimpleVector& other, const Alloc& alloc)
+        : items_(AllocateStorage(other.size_, alloc))
     {
-        std::copy(other.begin(), other.end(), items_.Get());
+        OnStorageChanged();
+        std::uninitialized_copy(other.Data(), other.Data() + other.size_, items_.Get());
+        size_ = other.size_;
+        Stats::OnCopy(size_, sizeof(Type));
     }
 
-    SimpleVector(ReserveProxyObj obj) {
+    SimpleVector(ReserveProxyObj obj, const Alloc& alloc = Alloc())
+        : items_(alloc)
+    {
         Reserve(obj.capacity_to_reserve_);
     }
 
-    // move конструктор
-    SimpleVector(SimpleVector&& other)
-        : items_(other.capacity_)
+    // move конструктор. Забирает память other вместе с аллокатором за O(1), ничего не выделяя.
+    // other остаётся пустым вектором с нулевой вместимостью
+    SimpleVector(SimpleVector&& other) noexcept
+        : items_(std::move(other.items_))
+        , size_(std::exchange(other.size_, 0))
     {
-        swap(other);
+        TakeAnnotation(other);
+    }
+
+    // Разрушает только живые элементы [0, size_). Память освобождает RawStorage
+    ~SimpleVector() {
+        std::destroy_n(items_.Get(), size_);
+        ReleaseAnnotation();
     }
 
     // Метод GetSize для получения количества элементов в векторе. Не выбрасывает исключений.
@@ -84,7 +376,12 @@ public:
     // Метод GetCapacity для получения вместимости вектора. Не выбрасывает исключений.
     // Возвращает вместимость массива
     size_t GetCapacity() const noexcept {
-        return capacity_;
+        return items_.GetCapacity();
+    }
+
+    // Возвращает копию аллокатора вектора
+    Alloc GetAllocator() const noexcept {
+        return items_.GetAllocator();
     }
 
     //Метод IsEmpty, сообщающий, пуст ли вектор. Не выбрасывает исключений.
@@ -97,11 +394,13 @@ public:
     // Для корректной работы оператора индекс элемента массива не должен выходить за пределы массива.
     // Возвращает ссылку на элемент с индексом index
     Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_DEBUG_CHECK(index < size_, "index out of range");
         return items_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
     const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_DEBUG_CHECK(index < size_, "index out of range");
         return items_[index];
     }
 
@@ -129,9 +428,11 @@ public:
     }
 
     // Метод Clear для очистки массива без изменения его вместимости. Не выбрасывает исключений.
-    // Обнуляет размер массива, не изменяя его вместимость
+    // Разрушает элементы и обнуляет размер массива, не изменяя его вместимость
     void Clear() noexcept {
+        std::destroy_n(items_.Get(), size_);
         size_ = 0;
+        Annotate(0);
     }
 
     // Изменяет размер массива.
@@ -142,28 +443,80 @@ public:
         2) новый размер не превышает его вместимости
         3) новый размер превышает текущую вместимость вектора.
 
-        Если при изменении размера массива новый размер вектора превышает его текущую вместимость, создаётся новый массив с нужной вместимостью,
-        копируется в него прежнее содержимое и заполнияются остальные элементы значением по умолчанию. Затем старый массив можно удалить и использовать копию.
-        После этого не обновляем размер и вместимость вектора.
+        Если при изменении размера массива новый размер вектора превышает его текущую вместимость, выделяется новая неинициализированная память,
+        в неё перемещается прежнее содержимое, а новые элементы создаются на месте значением по умолчанию. Ячейки за пределами size_ не конструируются.
+
+        Если при увеличении размера массива новый размер вектора не превышает его вместимость, создаём добавленные элементы значением по умолчанию для типа Type.
+        При уменьшении размера вектора разрушаем лишние элементы. */
+        if (new_size < size_) {
+            std::destroy(items_ + new_size, items_ + size_);
+        }
+        else if (new_size > size_) {
+            if (new_size > GetCapacity()) {
+                Reallocate(NextCapacity(new_size));
+            }
+            AnnotationScope annotation(*this, new_size);
+            std::uninitialized_value_construct(items_ + size_, items_ + new_size);
+            annotation.Commit();
+        }
+        size_ = new_size;
+        Annotate(size_);
+    }
+
+    // Изменяет размер массива. При увеличении размера новые элементы становятся копиями value.
+    // value может ссылаться на элемент самого вектора
+    void Resize(size_t new_size, const Type& value) {
+        if (new_size < size_) {
+            std::destroy(items_ + new_size, items_ + size_);
+        }
+        else if (new_size > GetCapacity()) {
+            // Копии создаются в новой памяти до переноса старых элементов, пока value ещё действительна
+            RawStorage<Type, Alloc> temp = GrowStorage(NextCapacity(new_size));
+            std::uninitialized_fill(temp + size_, temp + new_size, value);
+            Stats::OnCopy(new_size - size_, sizeof(Type));
+            RelocateTo(temp, size_, new_size - size_);
+        }
+        else if (new_size > size_) {
+            AnnotationScope annotation(*this, new_size);
+            std::uninitialized_fill(items_ + size_, items_ + new_size, value);
+            annotation.Commit();
+            Stats::OnCopy(new_size - size_, sizeof(Type));
+        }
+        size_ = new_size;
+        Annotate(size_);
+    }
 
-        Если при увеличении размера массива новый размер вектора не превышает его вместимость, заполняем добавленные элементы значением по умолчанию для типа Type.
-        При уменьшении размера вектора уменьшаем его размер. */
-        if (new_size <= size_) {
-            size_ = new_size;
+    // Как Resize, но новые элементы инициализируются по умолчанию: у тривиальных типов (char, uint8_t, POD-структур)
+    // их память не заполняется нулями. Подходит для буферов, которые сразу заполнит recv, read или распаковщик
+    void ResizeDefaultInit(size_t new_size) {
+        if (new_size < size_) {
+            std::destroy(items_ + new_size, items_ + size_);
         }
-        if (new_size <= capacity_) {
-            Fill(items_.Get() + size_, items_.Get() + size_ + new_size);
+        else if (new_size > size_) {
+            if (new_size > GetCapacity()) {
+                Reallocate(NextCapacity(new_size));
+            }
+            AnnotationScope annotation(*this, new_size);
+            std::uninitialized_default_construct(items_ + size_, items_ + new_size);
+            annotation.Commit();
         }
-        if (new_size > capacity_) {
-            size_t new_capacity = std::max(new_size, capacity_ * 2);
-            ArrayPtr<Type> temp(new_capacity);
-            Fill(temp.Get(), temp.Get() + new_capacity);
-            std::move(items_.Get(), items_.Get() + capacity_, temp.Get());
-            items_.swap(temp);
+        size_ = new_size;
+        Annotate(size_);
+    }
 
-            size_ = new_size;
-            capacity_ = new_capacity;
+    // Добавляет в конец count элементов без инициализации и возвращает указатель на первый из них,
+    // чтобы вызывающий код записал в них данные напрямую. До записи читать эти элементы нельзя.
+    // Указатель действителен до следующего перевыделения памяти
+    Type* AppendUninitialized(size_t count) {
+        static_assert(std::is_trivially_default_constructible_v<Type> && std::is_trivially_destructible_v<Type>,
+                      "AppendUninitialized requires a trivial element type; use ResizeDefaultInit otherwise");
+        if (size_ + count > GetCapacity()) {
+            Reallocate(NextCapacity(size_ + count));
         }
+        Type* first = items_ + size_;
+        size_ += count;
+        Annotate(size_);
+        return first;
     }
 
     // Методы begin, end, cbegin и cend, возвращающие итераторы на начало и конец массива. В качестве итераторов используйте указатели. 
@@ -172,82 +525,119 @@ public:
     // Возвращает итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
     Iterator begin() noexcept {
-        return items_.Get();
+        return MakeIterator(items_.Get());
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
     Iterator end() noexcept {
-        return items_.Get() + size_;
+        return MakeIterator(items_.Get() + size_);
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
     ConstIterator begin() const noexcept {
-        return items_.Get();
+        return MakeIterator(items_.Get());
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
     ConstIterator end() const noexcept {
-        return items_.Get() + size_;
+        return MakeIterator(items_.Get() + size_);
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
     ConstIterator cbegin() const noexcept {
-        return items_.Get();
+        return MakeIterator(items_.Get());
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
     ConstIterator cend() const noexcept {
-        return items_.Get() + size_;
+        return MakeIterator(items_.Get() + size_);
+    }
+
+    // Указатель на первый элемент. В отладочном режиме, в отличие от begin(), остаётся простым указателем без проверок
+    Type* Data() noexcept {
+        return items_.Get();
+    }
+
+    const Type* Data() const noexcept {
+        return items_.Get();
     }
 
     // Оператор присваивания. Должен обеспечивать строгую гарантию безопасности исключений.
+    // Аллокатор rhs перенимается, только если этого требует propagate_on_container_copy_assignment
     SimpleVector& operator=(const SimpleVector& rhs) {
         if (this != &rhs) {
-            SimpleVector temp(rhs);
-            swap(temp);
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                SimpleVector temp(rhs, rhs.GetAllocator());
+                swap(temp);
+            }
+            else {
+                SimpleVector temp(rhs, GetAllocator());
+                swap(temp);
+            }
         }
         return *this;
     }
 
-    // Перемещающий оператор присваивания 
-    SimpleVector& operator=(SimpleVector&& rhs) noexcept {
+    // Перемещающий оператор присваивания.
+    // Если аллокаторы не равны и не распространяются при перемещении (как у std::pmr::polymorphic_allocator),
+    // память rhs забрать нельзя, и элементы переносятся по одному в память этого вектора
+    SimpleVector& operator=(SimpleVector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                                         || AllocTraits::is_always_equal::value) {
         if (this != &rhs) {
-            items_ = std::move(rhs.items_);
-            size_ = std::exchange(rhs.size_, 0);
-            capacity_ = std::exchange(rhs.capacity_, 0);
-
-            rhs.size_ = 0;
-            rhs.capacity_ = 0;
+            Clear();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
+                ReleaseAnnotation();
+                items_ = std::move(rhs.items_);
+                size_ = std::exchange(rhs.size_, 0);
+                TakeAnnotation(rhs);
+            }
+            else if (GetAllocator() == rhs.GetAllocator()) {
+                ReleaseAnnotation();
+                items_ = std::move(rhs.items_);
+                size_ = std::exchange(rhs.size_, 0);
+                TakeAnnotation(rhs);
+            }
+            else {
+                Reserve(rhs.size_);
+                Annotate(rhs.size_);
+                std::uninitialized_move(rhs.Data(), rhs.Data() + rhs.size_, items_.Get());
+                Stats::OnRelocate(rhs.size_, sizeof(Type));
+                size_ = rhs.size_;
+                rhs.Clear();
+            }
         }
         return *this;
     }
 
     // Добавляет элемент в конец вектора
-    // При нехватке места увеличивает вдвое вместимость вектора
+    // При нехватке места увеличивает вместимость вектора согласно GrowthPolicy (по умолчанию вдвое)
     void PushBack(const Type& item) {
-        if (size_ < capacity_) {
-            //Resize(size_ + 1);
-            items_[size_++] = item;
-        }
-        else if (size_ == capacity_) {
-            Resize(capacity_ + 1);
-            items_[size_ - 1] = item; // size_ - 1 добавляет в конец 
-        }
+        EmplaceBack(item);
     }
 
     void PushBack(Type&& item) {
-        if (size_ < capacity_) {
-            items_[size_++] = std::move(item);
+        EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args прямо в его итоговой ячейке.
+    // При нехватке места увеличивает вдвое вместимость вектора. Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            // Элемент создаётся до переноса старых, поэтому args могут ссылаться на элементы самого вектора
+            EmplaceWithReallocation(size_, std::forward<Args>(args)...);
         }
-        else if (size_ == capacity_) {
-            Resize(capacity_ + 1);
-            items_[size_ - 1] = std::move(item); // size_ - 1 добавляет в конец 
+        else {
+            AnnotationScope annotation(*this, size_ + 1);
+            new (items_ + size_) Type(std::forward<Args>(args)...);
+            annotation.Commit();
         }
+        return items_[size_++];
     }
 
     // Вставляет значение value в позицию pos.
@@ -255,57 +645,44 @@ public:
     // Если перед вставкой значения вектор был заполнен полностью,
     // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью 0 стать равной 1
     Iterator Insert(ConstIterator pos, const Type& value) {
-        assert(pos >= begin() && pos <= end());
-        size_t count = pos - begin();
-        if (size_ < capacity_) {
-            std::copy_backward(begin() + count, end(), end() + 1);
-            *pos = value;
-        }
-        else {
-            size_t new_capacity = std::max(size_ + 1, capacity_ * 2);
-            ArrayPtr<Type> temp(new_capacity);
-            auto new_pos = temp.Get() + count;
-            std::copy(begin(), pos, temp.Get());
-            *new_pos = value;
-            std::copy(pos, end(), new_pos + 1);
-            items_.swap(temp);
-            capacity_ = new_capacity;
-        }
-        ++size_;
-        return begin() + count;
+        return Emplace(pos, value);
     }
 
     Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos. Возвращает итератор на созданный элемент.
+    // При переполнении элемент конструируется сразу в новой памяти, без промежуточных копий
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
         assert(pos >= begin() && pos <= end());
-        size_t count = pos - items_.Get();
-        if (capacity_ == 0) {
-            ArrayPtr<Type> temp(1);
-            temp[count] = std::move(value);
-            items_.swap(temp);
-            ++capacity_;
+        size_t count = IndexOf(pos);
+        SIMPLE_VECTOR_DEBUG_CHECK(count <= size_, "insert position out of range");
+        if (size_ == GetCapacity()) {
+            EmplaceWithReallocation(count, std::forward<Args>(args)...);
         }
-        else if (size_ < capacity_) {
-            std::move_backward(items_.Get() + count, items_.Get() + size_, items_.Get() + size_ + 1);
-            items_[count] = std::move(value);
+        else if (count == size_) {
+            AnnotationScope annotation(*this, size_ + 1);
+            new (items_ + size_) Type(std::forward<Args>(args)...);
+            annotation.Commit();
         }
         else {
-            size_t new_capacity = std::max(size_ + 1, capacity_ * 2);
-            ArrayPtr<Type> temp(new_capacity);
-            std::move(items_.Get(), items_.Get() + size_, temp.Get());
-            std::move_backward(items_.Get() + count, items_.Get() + size_, temp.Get() + size_ + 1);
-            temp[count] = std::move(value);
-            items_.swap(temp);
-            capacity_ = new_capacity;
+            AnnotationScope annotation(*this, size_ + 1);
+            detail::EmplaceShifting(items_.Get(), size_, count, std::forward<Args>(args)...);
+            annotation.Commit();
         }
         ++size_;
-
-        return &items_[count];
+        return begin() + count;
     }
 
-    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
     void PopBack() noexcept {
         assert(!IsEmpty());
+        SIMPLE_VECTOR_DEBUG_CHECK(!IsEmpty(), "PopBack on empty vector");
         --size_;
+        std::destroy_at(items_ + size_);
+        Annotate(size_);
     }
 
     // Удаляет элемент вектора в указанной позиции
@@ -313,44 +690,404 @@ public:
         assert(pos != this->end());
         assert(pos >= this->begin());
 
-        size_t count = pos - items_.Get();
-        std::move(items_.Get() + count + 1, items_.Get() + size_, items_.Get() + count);
+        size_t count = IndexOf(pos);
+        SIMPLE_VECTOR_DEBUG_CHECK(count < size_, "erase position out of range");
+        detail::EraseShifting(items_.Get(), size_, count);
         --size_;
-        return &items_[count];
+        Annotate(size_);
+        return begin() + count;
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост один раз. Возвращает итератор на элемент, следовавший за удалёнными
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(begin() <= first && first <= last && last <= end());
+        const size_t index = IndexOf(first);
+        const size_t count = IndexOf(last) - index;
+        SIMPLE_VECTOR_DEBUG_CHECK(index <= size_ && index + count <= size_, "erase range out of range");
+        if (count != 0) {
+            detail::EraseRangeShifting(items_.Get(), size_, index, count);
+            size_ -= count;
+            Annotate(size_);
+        }
+        return begin() + index;
     }
 
+    // Удаляет все элементы, для которых pred возвращает true, за один проход с сохранением порядка.
+    // Возвращает количество удалённых элементов
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        const size_t old_size = size_;
+        size_ = detail::RemoveIfCompacting(items_.Get(), size_, pred);
+        Annotate(size_);
+        return old_size - size_;
+    }
 
-    // Обменивает значение с другим вектором
+    // Удаляет элемент за O(1), ставя на его место последний. Порядок элементов не сохраняется.
+    // Возвращает итератор на элемент, занявший позицию pos (или end(), если удалён последний)
+    Iterator SwapRemove(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+        const size_t index = IndexOf(pos);
+        SIMPLE_VECTOR_DEBUG_CHECK(index < size_, "erase position out of range");
+        detail::SwapRemoveLast(items_.Get(), size_, index);
+        --size_;
+        Annotate(size_);
+        return begin() + index;
+    }
+
+
+    // Добавляет копии элементов [first, last) в конец вектора.
+    // Для forward-итераторов итоговый размер вычисляется заранее, и память перевыделяется не больше одного раза.
+    // Диапазон может указывать на элементы самого вектора
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    void Append(InputIt first, InputIt last) {
+        if constexpr (detail::kIsForwardIterator<InputIt>) {
+            const size_t count = std::distance(first, last);
+            if (size_ + count > GetCapacity()) {
+                // Новые элементы копируются до переноса старых, поэтому диапазон остаётся валидным
+                RawStorage<Type, Alloc> temp = GrowStorage(NextCapacity(size_ + count));
+                detail::UninitializedCopy(first, last, temp + size_);
+                RelocateTo(temp, size_, count);
+            }
+            else {
+                AnnotationScope annotation(*this, size_ + count);
+                detail::UninitializedCopy(first, last, items_ + size_);
+                annotation.Commit();
+            }
+            size_ += count;
+            Annotate(size_);
+            Stats::OnCopy(count, sizeof(Type));
+        }
+        else {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    // Заменяет содержимое вектора копиями элементов [first, last).
+    // Для forward-итераторов при нехватке места выделяется память ровно под новый размер.
+    // Диапазон не должен указывать на элементы самого вектора
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    void Assign(InputIt first, InputIt last) {
+        Clear();
+        if constexpr (detail::kIsForwardIterator<InputIt>) {
+            const size_t count = std::distance(first, last);
+            if (count > GetCapacity()) {
+                RawStorage<Type, Alloc> temp = GrowStorage(count);
+                ReplaceStorage(temp);
+            }
+            AnnotationScope annotation(*this, count);
+            detail::UninitializedCopy(first, last, items_.Get());
+            annotation.Commit();
+            size_ = count;
+            Stats::OnCopy(count, sizeof(Type));
+        }
+        else {
+            Append(first, last);
+        }
+    }
+
+    // Вставляет копии элементов [first, last) в позицию pos. Возвращает итератор на первый вставленный элемент.
+    // Хвост вектора сдвигается один раз, а не для каждого элемента. Диапазон может указывать на элементы самого вектора
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    Iterator InsertRange(ConstIterator pos, InputIt first, InputIt last) {
+        assert(pos >= begin() && pos <= end());
+        const size_t index = IndexOf(pos);
+        SIMPLE_VECTOR_DEBUG_CHECK(index <= size_, "insert position out of range");
+        if constexpr (detail::kIsForwardIterator<InputIt>) {
+            const size_t count = std::distance(first, last);
+            if (size_ + count > GetCapacity()) {
+                // Диапазон копируется сразу на итоговое место, старые элементы переносятся вокруг него
+                RawStorage<Type, Alloc> temp = GrowStorage(NextCapacity(size_ + count));
+                detail::UninitializedCopy(first, last, temp + index);
+                RelocateTo(temp, index, count);
+                size_ += count;
+                Annotate(size_);
+                Stats::OnCopy(count, sizeof(Type));
+                return begin() + index;
+            }
+        }
+        // Элементы дописываются в свободную память за концом и одним поворотом переставляются на место
+        const size_t old_size = size_;
+        Append(first, last);
+        std::rotate(begin() + index, begin() + old_size, end());
+        return begin() + index;
+    }
+
+    // Дописывает count элементов, которые создаёт construct(Type* first) в неинициализированной памяти за концом вектора.
+    // construct должен создать ровно count элементов, а выбрасывая исключение — разрушить уже созданные.
+    // Нужен алгоритмам, которые создают элементы сами, например параллельно (см. simple_vector_parallel.h)
+    template <typename Constructor>
+    void AppendConstructed(size_t count, Constructor construct) {
+        if (size_ + count > GetCapacity()) {
+            Reallocate(NextCapacity(size_ + count));
+        }
+        AnnotationScope annotation(*this, size_ + count);
+        construct(items_ + size_);
+        annotation.Commit();
+        size_ += count;
+    }
+
+    // Хеш содержимого, согласованный с operator==: у равных векторов равные отпечатки.
+    // Элементы, которые равны тогда и только тогда, когда равны их байты (целые, перечисления, указатели),
+    // хешируются одним проходом по памяти (см. byte_hash.h), остальные — поэлементно через std::hash<Type>.
+    // Значение не кешируется: неконстантные operator[], begin() и Data() меняют элементы незаметно для вектора
+    uint64_t Fingerprint() const noexcept(detail::kBytewiseEqual<Type>) {
+        if constexpr (detail::kBytewiseEqual<Type>) {
+            return detail::HashBytes(items_.Get(), size_ * sizeof(Type));
+        }
+        else {
+            uint64_t hash = 0;
+            for (size_t i = 0; i < size_; ++i) {
+                hash = detail::HashCombine(hash, std::hash<Type>{}(items_[i]));
+            }
+            return detail::HashCombine(hash, size_);
+        }
+    }
+
+    // Обменивает значение с другим вектором. Если аллокатор не распространяется при обмене,
+    // аллокаторы векторов должны быть равны
     void swap(SimpleVector& other) noexcept {
         items_.swap(other.items_);
         std::swap(size_, other.size_);
-        std::swap(capacity_, other.capacity_);
+        SwapAnnotation(other);
     }
 
     // Reserve сразу выделяет нужное количество памяти. При добавлении новых элементов в вектор копирование будет происходить или значительно реже или совсем не будет.
     // Если new_capacity больше текущей capacity, память должна быть перевыделена, а элементы вектора скопированы в новый отрезок памяти.
     void Reserve(size_t new_capacity) {
-        if (new_capacity > capacity_) {
-            ArrayPtr<Type> temp(new_capacity);
-            if (size_ > 0) {
-                std::copy(items_.Get(), items_.Get() + size_, temp.Get());
-            }
-            items_.swap(temp);
-            capacity_ = new_capacity;
+        if (new_capacity > GetCapacity()) {
+            Reallocate(new_capacity);
+            Annotate(size_);
         }
     }
 
+    // Уменьшает вместимость до размера, возвращая лишнюю память аллокатору. Пустой вектор освобождает память целиком.
+    // Тривиально перемещаемые элементы остаются на месте, если realloc может ужать блок без переноса
+    void ShrinkToFit() {
+        if (size_ == 0) {
+            RawStorage<Type, Alloc> empty(items_.GetAllocator());
+            ReplaceStorage(empty);
+        }
+        else if (size_ < GetCapacity()) {
+            Reallocate(size_);
+        }
+    }
+
+    // Разрушает элементы и освобождает всю память: вектор становится таким же, как только что созданный
+    void Reset() noexcept {
+        Clear();
+        RawStorage<Type, Alloc> empty(items_.GetAllocator());
+        ReplaceStorage(empty);
+    }
+
 private:
-    ArrayPtr<Type> items_{};
-    size_t capacity_{};
+    // Для тривиально перемещаемых типов перенос элементов выполняется побайтово (memcpy/memmove/realloc)
+    static constexpr bool kTriviallyRelocatable = IsTriviallyRelocatable<Type>::value;
+
+    RawStorage<Type, Alloc> items_{};
     size_t size_{};
+#ifdef SIMPLE_VECTOR_DEBUG
+    template <typename, typename>
+    friend class detail::CheckedIterator;
+
+    // Меняется при каждой смене буфера и делает недействительными выданные итераторы
+    size_t generation_ = 0;
+    // Для ASan открыта часть буфера [0, annotated_size_), остальное помечено недоступным
+    size_t annotated_size_ = 0;
+
+    size_t GetGeneration() const noexcept {
+        return generation_;
+    }
+#endif
+
+    Iterator MakeIterator(Type* ptr) noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        return Iterator(ptr, this);
+#else
+        return ptr;
+#endif
+    }
+
+    ConstIterator MakeIterator(const Type* ptr) const noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        return ConstIterator(ptr, this);
+#else
+        return ptr;
+#endif
+    }
+
+    // Индекс элемента, на который указывает pos. В отладочном режиме проверяет, что pos выдан этим вектором
+    // и с тех пор его память не перевыделялась
+    size_t IndexOf(ConstIterator pos) const noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        SIMPLE_VECTOR_DEBUG_CHECK(pos.IsValidFor(this), "iterator is invalidated or belongs to another vector");
+        return pos.Get() - items_.Get();
+#else
+        return pos - items_.Get();
+#endif
+    }
+
+    // Оставляет доступными для ASan только первые size ячеек буфера. Перед записью за конец вектора
+    // вызывающий код открывает нужные ячейки, а по завершении операции закрывает всё за size_.
+    // Вне отладочного режима под ASan ничего не делает
+    void Annotate([[maybe_unused]] size_t size) noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        const Type* data = items_.Get();
+        detail::AnnotateContiguousContainer(data, data + GetCapacity(), data + annotated_size_, data + size);
+        annotated_size_ = size;
+#endif
+    }
+
+    // Открывает для ASan ячейки до size на время их заполнения. Если заполнение выбросит исключение до Commit,
+    // деструктор снова закрывает всё за size_, и неинициализированная ячейка за концом не остаётся доступной
+    class AnnotationScope {
+    public:
+        AnnotationScope(SimpleVector& v, size_t size) noexcept
+            : vector_(v)
+        {
+            vector_.Annotate(size);
+        }
 
-    void Fill(Iterator first, Iterator last) {
-        assert(first < last);
+        AnnotationScope(const AnnotationScope&) = delete;
+        AnnotationScope& operator=(const AnnotationScope&) = delete;
 
-        for (; first != last; ++first) {
-            *first = std::move(Type());
+        ~AnnotationScope() {
+#if defined(SIMPLE_VECTOR_ANNOTATE_CONTAINER)
+            if (!committed_) {
+                vector_.Annotate(vector_.size_);
+            }
+#endif
         }
+
+        // Ячейки заполнены: разметку дальше ведёт вызывающий код
+        void Commit() noexcept {
+#if defined(SIMPLE_VECTOR_ANNOTATE_CONTAINER)
+            committed_ = true;
+#endif
+        }
+
+    private:
+        SimpleVector& vector_;
+#if defined(SIMPLE_VECTOR_ANNOTATE_CONTAINER)
+        bool committed_ = false;
+#endif
+    };
+
+    // Открывает буфер целиком перед тем, как он будет освобождён или передан другому владельцу
+    void ReleaseAnnotation() noexcept {
+        Annotate(GetCapacity());
+    }
+
+    // Отмечает, что вектор получил новый буфер: его память ещё не размечена, а старые итераторы недействительны
+    void OnStorageChanged() noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        annotated_size_ = GetCapacity();
+        ++generation_;
+#endif
+    }
+
+    // Забирает разметку буфера, который перешёл от other к этому вектору
+    void TakeAnnotation([[maybe_unused]] SimpleVector& other) noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        annotated_size_ = std::exchange(other.annotated_size_, 0);
+        ++generation_;
+        ++other.generation_;
+#endif
+    }
+
+    // Обменивает разметку буферов вместе с самими буферами. Итераторы обоих векторов становятся недействительными
+    void SwapAnnotation([[maybe_unused]] SimpleVector& other) noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        std::swap(annotated_size_, other.annotated_size_);
+        ++generation_;
+        ++other.generation_;
+#endif
+    }
+
+    // Делает temp хранилищем вектора. Прежний буфер, открытый целиком, оказывается в temp
+    void ReplaceStorage(RawStorage<Type, Alloc>& temp) noexcept {
+        ReleaseAnnotation();
+        items_.swap(temp);
+        OnStorageChanged();
+    }
+
+    // Вместимость, до которой растёт вектор, которому нужно required ячеек
+    size_t NextCapacity(size_t required) const noexcept {
+        return GrowthPolicy::NextCapacity(GetCapacity(), required, sizeof(Type));
+    }
+
+    // Переносит элементы в новую память вместимостью new_capacity
+    void Reallocate(size_t new_capacity) {
+        if constexpr (kTriviallyRelocatable && RawStorage<Type, Alloc>::kCanReallocate) {
+            const size_t old_capacity = GetCapacity();
+            ReleaseAnnotation();
+            items_.Reallocate(new_capacity);
+            OnStorageChanged();
+            Stats::OnAllocate(old_capacity, new_capacity, sizeof(Type));
+        }
+        else {
+            RawStorage<Type, Alloc> temp = GrowStorage(new_capacity);
+            detail::RelocateElements(items_.Get(), size_, temp.Get());
+            ReplaceStorage(temp);
+        }
+        Stats::OnRelocate(size_, sizeof(Type));
+    }
+
+    // Выделяет память под элементы нового вектора
+    static RawStorage<Type, Alloc> AllocateStorage(size_t capacity, const Alloc& alloc) {
+        RawStorage<Type, Alloc> storage(capacity, alloc);
+        if (capacity != 0) {
+            Stats::OnAllocate(0, capacity, sizeof(Type));
+        }
+        return storage;
+    }
+
+    // Выделяет память, которая заменит текущую
+    RawStorage<Type, Alloc> GrowStorage(size_t new_capacity) {
+        RawStorage<Type, Alloc> storage(new_capacity, items_.GetAllocator());
+        Stats::OnAllocate(GetCapacity(), new_capacity, sizeof(Type));
+        return storage;
+    }
+
+    // Увеличивает вместимость и создаёт элемент в ячейке index, сдвигая элементы [index, size_) вправо.
+    // size_ не изменяется: это делает вызывающий код
+    template <typename... Args>
+    void EmplaceWithReallocation(size_t index, Args&&... args) {
+        const size_t new_capacity = NextCapacity(size_ + 1);
+        // size_ + 1 переполняется только у вектора из SIZE_MAX элементов. Проверка заодно показывает компилятору,
+        // что ячейка index лежит внутри новой памяти: без неё GCC 12 с -O2 выдаёт ложное -Warray-bounds
+        if (new_capacity <= size_) {
+            throw std::length_error("SimpleVector is too large");
+        }
+        if constexpr (detail::kRelocateThroughStack<Type> && RawStorage<Type, Alloc>::kCanReallocate) {
+            // Элемент создаётся до realloc, так как args могут ссылаться на старую память
+            alignas(Type) unsigned char buffer[sizeof(Type)];
+            Type* value = new (buffer) Type(std::forward<Args>(args)...);
+            try {
+                Reallocate(new_capacity);
+            }
+            catch (...) {
+                std::destroy_at(value);
+                throw;
+            }
+            detail::MoveBytes(items_ + index, size_ - index, items_ + index + 1);
+            detail::RelocateBytes(value, 1, items_ + index);
+        }
+        else {
+            RawStorage<Type, Alloc> temp = GrowStorage(new_capacity);
+            new (temp.Get() + index) Type(std::forward<Args>(args)...);
+            RelocateTo(temp, index);
+        }
+        Annotate(size_ + 1);
+    }
+
+    // Переносит живые элементы в temp вокруг gap_size ячеек, начиная с gap, которые вызывающий код уже заполнил новыми элементами.
+    // Затем temp становится хранилищем вектора. Если перенос выбросил исключение, новые элементы разрушаются
+    void RelocateTo(RawStorage<Type, Alloc>& temp, size_t gap, size_t gap_size = 1) {
+        detail::RelocateAroundGap(items_.Get(), size_, temp.Get(), gap, gap_size);
+        ReplaceStorage(temp);
+        Stats::OnRelocate(size_, sizeof(Type));
     }
 };
 
@@ -358,35 +1095,47 @@ ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
 }
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+inline bool operator==(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
     if (&lhs == &rhs) {
         return true;
     }
-    return (lhs.GetSize() == rhs.GetSize()) && std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    return detail::RangesEqual(lhs.Data(), lhs.GetSize(), rhs.Data(), rhs.GetSize());
 }
 
-template <typename Type>
-bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+bool operator!=(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+bool operator<(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
+    return detail::RangesLess(lhs.Data(), lhs.GetSize(), rhs.Data(), rhs.GetSize());
 }
 
-template <typename Type>
-bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+bool operator<=(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
     return !(rhs < lhs);
 }
 
-template <typename Type>
-bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+bool operator>(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
     return (rhs < lhs);
 }
 
-template <typename Type>
-bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+bool operator>=(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
     return !(lhs < rhs);
 }
+
+namespace std {
+
+// Позволяет использовать SimpleVector ключом std::unordered_map и std::unordered_set
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+struct hash<SimpleVector<Type, Alloc, GrowthPolicy, Stats>> {
+    size_t operator()(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v) const noexcept(noexcept(v.Fingerprint())) {
+        return static_cast<size_t>(v.Fingerprint());
+    }
+};
+
+} // namespace std
@@ -0,0 +1,219 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+// Отладочный режим SimpleVector включается макросом SIMPLE_VECTOR_DEBUG (например, -DSIMPLE_VECTOR_DEBUG).
+// В нём:
+//  - итераторы — CheckedIterator: они помнят поколение памяти вектора и проверяют при каждом
+//    разыменовании и сдвиге, что память не перевыделялась и позиция не вышла за [begin, end];
+//  - operator[], PopBack, Insert, Erase проверяют индексы и позиции. Проверки работают и с NDEBUG,
+//    поэтому режим можно включать в оптимизированных канареечных сборках;
+//  - под AddressSanitizer неиспользуемая вместимость [size, capacity) помечается недоступной
+//    (__sanitizer_annotate_contiguous_container), и ASan сообщает о чтении или записи за концом вектора.
+// Без макроса итераторы остаются указателями, а вектор не хранит ничего лишнего
+
+#if defined(SIMPLE_VECTOR_DEBUG)
+#if defined(__SANITIZE_ADDRESS__)
+#define SIMPLE_VECTOR_ANNOTATE_CONTAINER 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define SIMPLE_VECTOR_ANNOTATE_CONTAINER 1
+#endif
+#endif
+#endif
+
+#if defined(SIMPLE_VECTOR_ANNOTATE_CONTAINER)
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+#if defined(SIMPLE_VECTOR_DEBUG)
+#define SIMPLE_VECTOR_DEBUG_CHECK(condition, message) \
+    ((condition) ? static_cast<void>(0) : ::detail::DebugCheckFailed(message, __FILE__, __LINE__))
+#else
+#define SIMPLE_VECTOR_DEBUG_CHECK(condition, message) static_cast<void>(0)
+#endif
+
+namespace detail {
+
+[[noreturn]] inline void DebugCheckFailed(const char* message, const char* file, int line) noexcept {
+    std::fprintf(stderr, "%s:%d: SimpleVector check failed: %s\n", file, line, message);
+    std::abort();
+}
+
+// Сообщает ASan, что в буфере [first, last) доступна теперь часть [first, new_mid) вместо [first, old_mid).
+// ASan размечает память гранулами по 8 байт, поэтому буферы с невыровненным началом (например, выданные
+// std::pmr::monotonic_buffer_resource) не размечаются. Вне ASan ничего не делает
+inline void AnnotateContiguousContainer([[maybe_unused]] const void* first, [[maybe_unused]] const void* last,
+                                        [[maybe_unused]] const void* old_mid, [[maybe_unused]] const void* new_mid) noexcept {
+#if defined(SIMPLE_VECTOR_ANNOTATE_CONTAINER)
+    constexpr std::uintptr_t kShadowGranularity = 8;
+    if (first != nullptr && old_mid != new_mid && reinterpret_cast<std::uintptr_t>(first) % kShadowGranularity == 0) {
+        __sanitizer_annotate_contiguous_container(first, last, old_mid, new_mid);
+    }
+#endif
+}
+
+// Итератор отладочного режима. Container должен объявить его другом и предоставить Data(), GetSize()
+// и закрытый GetGeneration(), который меняется при каждой смене буфера элементов.
+// Перемещение и обмен векторов тоже делают итераторы недействительными: они привязаны к объекту вектора
+template <typename Type, typename Container>
+class CheckedIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Type>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Type*;
+    using reference = Type&;
+
+    CheckedIterator() noexcept = default;
+
+    CheckedIterator(Type* ptr, const Container* owner) noexcept
+        : ptr_(ptr)
+        , owner_(owner)
+        , generation_(owner->GetGeneration())
+    {}
+
+    // Изменяемый итератор неявно превращается в константный
+    template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Type> && !std::is_const_v<Other>>>
+    CheckedIterator(const CheckedIterator<Other, Container>& other) noexcept
+        : ptr_(other.ptr_)
+        , owner_(other.owner_)
+        , generation_(other.generation_)
+    {}
+
+    // Указатель на элемент без проверок
+    Type* Get() const noexcept {
+        return ptr_;
+    }
+
+    // Итератор получен от owner, и с тех пор его память не перевыделялась
+    bool IsValidFor(const Container* owner) const noexcept {
+        return owner_ == owner && owner != nullptr && generation_ == owner->GetGeneration();
+    }
+
+    Type& operator*() const noexcept {
+        CheckDereferenceable();
+        return *ptr_;
+    }
+
+    Type* operator->() const noexcept {
+        CheckDereferenceable();
+        return ptr_;
+    }
+
+    Type& operator[](difference_type offset) const noexcept {
+        return *(*this + offset);
+    }
+
+    CheckedIterator& operator++() noexcept {
+        return *this += 1;
+    }
+
+    CheckedIterator operator++(int) noexcept {
+        CheckedIterator old = *this;
+        *this += 1;
+        return old;
+    }
+
+    CheckedIterator& operator--() noexcept {
+        return *this -= 1;
+    }
+
+    CheckedIterator operator--(int) noexcept {
+        CheckedIterator old = *this;
+        *this -= 1;
+        return old;
+    }
+
+    CheckedIterator& operator+=(difference_type offset) noexcept {
+        CheckValid();
+        const difference_type index = Index() + offset;
+        SIMPLE_VECTOR_DEBUG_CHECK(index >= 0 && static_cast<size_t>(index) <= owner_->GetSize(), "iterator moved out of [begin, end]");
+        ptr_ += offset;
+        return *this;
+    }
+
+    CheckedIterator& operator-=(difference_type offset) noexcept {
+        return *this += -offset;
+    }
+
+    friend CheckedIterator operator+(CheckedIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend CheckedIterator operator+(difference_type offset, CheckedIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend CheckedIterator operator-(CheckedIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        lhs.CheckComparable(rhs);
+        return lhs.ptr_ - rhs.ptr_;
+    }
+
+    friend bool operator==(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        lhs.CheckComparable(rhs);
+        return lhs.ptr_ == rhs.ptr_;
+    }
+
+    friend bool operator!=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        lhs.CheckComparable(rhs);
+        return lhs.ptr_ < rhs.ptr_;
+    }
+
+    friend bool operator>(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+private:
+    template <typename, typename>
+    friend class CheckedIterator;
+
+    Type* ptr_ = nullptr;
+    const Container* owner_ = nullptr;
+    size_t generation_ = 0;
+
+    difference_type Index() const noexcept {
+        return ptr_ - owner_->Data();
+    }
+
+    void CheckValid() const noexcept {
+        SIMPLE_VECTOR_DEBUG_CHECK(owner_ != nullptr, "singular iterator");
+        SIMPLE_VECTOR_DEBUG_CHECK(generation_ == owner_->GetGeneration(), "iterator invalidated by reallocation");
+    }
+
+    void CheckDereferenceable() const noexcept {
+        CheckValid();
+        SIMPLE_VECTOR_DEBUG_CHECK(Index() >= 0 && static_cast<size_t>(Index()) < owner_->GetSize(), "dereferencing iterator out of [begin, end)");
+    }
+
+    // Сравнивать можно только итераторы одного вектора; два итератора по умолчанию тоже сравнимы
+    void CheckComparable(const CheckedIterator& other) const noexcept {
+        SIMPLE_VECTOR_DEBUG_CHECK(owner_ == other.owner_, "comparing iterators of different vectors");
+        if (owner_ != nullptr) {
+            CheckValid();
+            other.CheckValid();
+        }
+    }
+};
+
+} // namespace detail
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "byte_hash.h"
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+
+// Двоичное сохранение и загрузка SimpleVector тривиально копируемых элементов.
+// Формат: 32-байтовый заголовок (сигнатура, размер элемента, метка типа, количество элементов, контрольная сумма),
+// за которым подряд идут байты элементов. Элементы пишутся одним вызовом write или memcpy, а из потока читаются частями.
+// Порядок байтов и выравнивание берутся как есть, поэтому файлы переносимы только между одинаковыми платформами
+
+// Метка типа элемента в заголовке. По умолчанию строится по typeid(Type).name(), который стабилен
+// для одного компилятора. Для обмена между разными компиляторами специализируйте трейт своей константой
+template <typename Type>
+struct SerializationTypeTag {
+    static uint64_t Get() noexcept;
+};
+
+namespace detail {
+
+inline constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+inline constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+inline uint64_t Fnv1a(const char* text) noexcept {
+    uint64_t hash = kFnvOffset;
+    for (; *text != '\0'; ++text) {
+        hash = (hash ^ static_cast<unsigned char>(*text)) * kFnvPrime;
+    }
+    return hash;
+}
+
+// Контрольная сумма элементов — тот же хеш, что у SimpleVector::Fingerprint. Формат "SVE2" полагается
+// на обещание HashBytes не менять результат (см. byte_hash.h)
+inline uint64_t Checksum(const void* data, size_t size) noexcept {
+    return HashBytes(data, size);
+}
+
+struct SerializedHeader {
+    uint32_t magic;
+    uint32_t element_size;
+    uint64_t type_tag;
+    uint64_t size;
+    uint64_t checksum;
+};
+static_assert(sizeof(SerializedHeader) == 32);
+
+// Вторая версия формата: контрольная сумма считается HashBytes, чей результат зафиксирован. Файлы первой версии ("SVEC") не читаются
+inline constexpr uint32_t kSerializedMagic = 0x32455653;  // "SVE2"
+
+// Сколько байт элементов LoadFrom из потока читает за один вызов read
+inline constexpr size_t kLoadChunkBytes = size_t(1) << 20;
+
+template <typename Type>
+SerializedHeader MakeSerializedHeader(const Type* items, size_t size) noexcept {
+    return { kSerializedMagic, sizeof(Type), SerializationTypeTag<Type>::Get(), size, Checksum(items, size * sizeof(Type)) };
+}
+
+// Проверяет заголовок и возвращает количество элементов
+template <typename Type>
+size_t CheckSerializedHeader(const SerializedHeader& header) {
+    if (header.magic != kSerializedMagic) {
+        throw std::runtime_error("not a serialized SimpleVector");
+    }
+    if (header.element_size != sizeof(Type) || header.type_tag != SerializationTypeTag<Type>::Get()) {
+        throw std::runtime_error("serialized SimpleVector has another element type");
+    }
+    if (header.size > SIZE_MAX / sizeof(Type)) {
+        throw std::runtime_error("serialized SimpleVector is too large");
+    }
+    return static_cast<size_t>(header.size);
+}
+
+} // namespace detail
+
+template <typename Type>
+uint64_t SerializationTypeTag<Type>::Get() noexcept {
+    return detail::Fnv1a(typeid(Type).name());
+}
+
+// Количество байт, которое займёт вектор после сохранения
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+size_t GetSerializedSize(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v) noexcept {
+    return sizeof(detail::SerializedHeader) + v.GetSize() * sizeof(Type);
+}
+
+// Записывает вектор в поток. При ошибке записи выбрасывает std::runtime_error
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+void SaveTo(std::ostream& out, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v) {
+    static_assert(std::is_trivially_copyable_v<Type>, "SaveTo writes elements as raw bytes");
+    const detail::SerializedHeader header = detail::MakeSerializedHeader(v.Data(), v.GetSize());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(v.Data()), static_cast<std::streamsize>(v.GetSize() * sizeof(Type)));
+    if (!out) {
+        throw std::runtime_error("failed to write SimpleVector");
+    }
+}
+
+// Заменяет содержимое вектора прочитанным из потока. При ошибке чтения, несовпадении типа или контрольной суммы
+// выбрасывает std::runtime_error, и вектор не изменяется.
+// Заголовку нельзя доверять: элементы читаются частями по kLoadChunkBytes, а память растёт удвоением
+// по мере фактически прочитанных данных, поэтому поддельный размер в усечённом потоке не заставит выделить лишнего
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+void LoadFrom(std::istream& in, SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v) {
+    static_assert(std::is_trivially_copyable_v<Type>, "LoadFrom reads elements as raw bytes");
+    detail::SerializedHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("failed to read SimpleVector header");
+    }
+    const size_t size = detail::CheckSerializedHeader<Type>(header);
+    constexpr size_t kChunkSize = std::max<size_t>(1, detail::kLoadChunkBytes / sizeof(Type));
+    SimpleVector<Type, Alloc, GrowthPolicy, Stats> loaded(v.GetAllocator());
+    while (loaded.GetSize() < size) {
+        const size_t count = std::min(size - loaded.GetSize(), kChunkSize);
+        if (loaded.GetSize() + count > loaded.GetCapacity()) {
+            // Последний шаг удвоения урезается до size, чтобы вместимость совпала с размером
+            loaded.Reserve(std::min(size, std::max(loaded.GetSize() + count, loaded.GetCapacity() * 2)));
+        }
+        loaded.AppendConstructed(count, [&](Type* dest) {
+            if (!in.read(reinterpret_cast<char*>(dest), static_cast<std::streamsize>(count * sizeof(Type)))) {
+                throw std::runtime_error("failed to read SimpleVector elements");
+            }
+        });
+    }
+    if (detail::Checksum(loaded.Data(), size * sizeof(Type)) != header.checksum) {
+        throw std::runtime_error("SimpleVector checksum mismatch");
+    }
+    v.swap(loaded);
+}
+
+// Записывает вектор в буфер buffer размером buffer_size байт и возвращает количество записанных байт.
+// Если буфер меньше GetSerializedSize(v), выбрасывает std::length_error
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+size_t SaveTo(void* buffer, size_t buffer_size, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v) {
+    static_assert(std::is_trivially_copyable_v<Type>, "SaveTo writes elements as raw bytes");
+    const size_t total = GetSerializedSize(v);
+    if (buffer_size < total) {
+        throw std::length_error("buffer is too small for SimpleVector");
+    }
+    const detail::SerializedHeader header = detail::MakeSerializedHeader(v.Data(), v.GetSize());
+    auto* bytes = static_cast<unsigned char*>(buffer);
+    std::memcpy(bytes, &header, sizeof(header));
+    if (!v.IsEmpty()) {
+        std::memcpy(bytes + sizeof(header), static_cast<const void*>(v.Data()), v.GetSize() * sizeof(Type));
+    }
+    return total;
+}
+
+// Заменяет содержимое вектора прочитанным из буфера и возвращает количество прочитанных байт.
+// Ошибки сообщаются так же, как в LoadFrom из потока, и вектор при ошибке тоже не изменяется
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+size_t LoadFrom(const void* buffer, size_t buffer_size, SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v) {
+    static_assert(std::is_trivially_copyable_v<Type>, "LoadFrom reads elements as raw bytes");
+    const auto* bytes = static_cast<const unsigned char*>(buffer);
+    detail::SerializedHeader header{};
+    if (buffer_size < sizeof(header)) {
+        throw std::runtime_error("failed to read SimpleVector header");
+    }
+    std::memcpy(&header, bytes, sizeof(header));
+    const size_t size = detail::CheckSerializedHeader<Type>(header);
+    if ((buffer_size - sizeof(header)) / sizeof(Type) < size) {
+        throw std::runtime_error("failed to read SimpleVector elements");
+    }
+    const unsigned char* payload = bytes + sizeof(header);
+    if (detail::Checksum(payload, size * sizeof(Type)) != header.checksum) {
+        throw std::runtime_error("SimpleVector checksum mismatch");
+    }
+    // Элементы копируются во временный вектор: если выделение памяти не удастся, v останется прежним
+    SimpleVector<Type, Alloc, GrowthPolicy, Stats> loaded(v.GetAllocator());
+    loaded.Reserve(size);
+    loaded.AppendConstructed(size, [&](Type* dest) {
+        if (size != 0) {
+            std::memcpy(static_cast<void*>(dest), payload, size * sizeof(Type));
+        }
+    });
+    v.swap(loaded);
+    return sizeof(header) + size * sizeof(Type);
+}
@@ -0,0 +1,377 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Параллельные алгоритмы над SimpleVector и его итераторами: заполнение, преобразование, свёртка, сортировка и копирование.
+// Работа делится на куски, границы которых по возможности выровнены на кэш-линии, чтобы соседние потоки
+// не писали в одну линию (false sharing). Маленькие диапазоны обрабатываются в вызывающем потоке
+
+// Фиксированный набор рабочих потоков. Вызывающий поток тоже участвует в работе, поэтому
+// вложенные вызовы RunTasks не приводят к взаимной блокировке
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t thread_count = std::max<size_t>(1, std::thread::hardware_concurrency())) {
+        // Один из исполнителей — сам вызывающий поток
+        try {
+            for (size_t i = 1; i < thread_count; ++i) {
+                workers_.EmplaceBack([this] {
+                    WorkerLoop();
+                });
+            }
+        }
+        catch (...) {
+            Stop();
+            throw;
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        Stop();
+    }
+
+    // Количество исполнителей с учётом вызывающего потока
+    size_t GetThreadCount() const noexcept {
+        return workers_.GetSize() + 1;
+    }
+
+    // Общий пул на все потоки машины
+    static ThreadPool& Default() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Вызывает task(i) для каждого i из [0, count) и дожидается завершения всех вызовов.
+    // Если какой-то вызов выбросил исключение, оставшиеся непройденными задачи пропускаются,
+    // а первое исключение пробрасывается после завершения уже начатых
+    template <typename Task>
+    void RunTasks(size_t count, Task task) {
+        if (count == 0) {
+            return;
+        }
+        if (count == 1 || workers_.IsEmpty()) {
+            for (size_t i = 0; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        // Состояние живёт, пока его держит хотя бы один помощник: опоздавшие помощники
+        // увидят, что задач не осталось, и сразу выйдут
+        auto batch = std::make_shared<Batch>(count, std::function<void(size_t)>(std::move(task)));
+        const size_t helpers = std::min(workers_.GetSize(), count - 1);
+        {
+            std::lock_guard lock(mutex_);
+            for (size_t i = 0; i < helpers; ++i) {
+                jobs_.push_back([batch] {
+                    batch->Work();
+                });
+            }
+        }
+        has_jobs_.notify_all();
+
+        batch->Work();
+        batch->Wait();
+        if (batch->error) {
+            std::rethrow_exception(batch->error);
+        }
+    }
+
+private:
+    struct Batch {
+        Batch(size_t task_count, std::function<void(size_t)> body)
+            : count(task_count)
+            , task(std::move(body))
+        {}
+
+        void Work() {
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                if (!failed.load(std::memory_order_relaxed)) {
+                    try {
+                        task(i);
+                    }
+                    catch (...) {
+                        std::lock_guard lock(mutex);
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+                if (completed.fetch_add(1) + 1 == count) {
+                    std::lock_guard lock(mutex);
+                    all_done.notify_all();
+                }
+            }
+        }
+
+        void Wait() {
+            std::unique_lock lock(mutex);
+            all_done.wait(lock, [this] {
+                return completed.load() == count;
+            });
+        }
+
+        const size_t count;
+        std::function<void(size_t)> task;
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> completed{ 0 };
+        std::atomic<bool> failed{ false };
+        std::mutex mutex;
+        std::condition_variable all_done;
+        std::exception_ptr error;
+    };
+
+    // Дожидается, пока рабочие потоки разберут очередь, и завершает их
+    void Stop() noexcept {
+        {
+            std::lock_guard lock(mutex_);
+            stopped_ = true;
+        }
+        has_jobs_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void WorkerLoop() {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(mutex_);
+                has_jobs_.wait(lock, [this] {
+                    return stopped_ || !jobs_.empty();
+                });
+                if (jobs_.empty()) {
+                    return;
+                }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable has_jobs_;
+    std::deque<std::function<void()>> jobs_;
+    bool stopped_ = false;
+    SimpleVector<std::thread> workers_;
+};
+
+namespace detail {
+
+inline constexpr size_t kCacheLineSize = 64;
+// Меньше этого количества элементов на поток делить работу невыгодно
+inline constexpr size_t kMinParallelChunk = 16 * 1024;
+
+// Разбиение [0, size) на куски. Для непрерывных последовательностей границы кусков, кроме крайних,
+// приходятся на начало кэш-линии: первый кусок укорачивается на head элементов до ближайшей границы
+class ChunkPlan {
+public:
+    ChunkPlan(size_t size, size_t parts, size_t element_size, const void* base)
+        : size_(size)
+    {
+        const size_t per_line = element_size < kCacheLineSize && kCacheLineSize % element_size == 0 ? kCacheLineSize / element_size : 1;
+        const size_t wanted = std::max(kMinParallelChunk, (size + parts - 1) / std::max<size_t>(parts, 1));
+        chunk_ = (wanted + per_line - 1) / per_line * per_line;
+        if (size <= chunk_) {
+            return;
+        }
+        if (base != nullptr && per_line > 1) {
+            const size_t misalignment = reinterpret_cast<uintptr_t>(base) % kCacheLineSize;
+            if (misalignment % element_size == 0) {
+                head_ = (per_line - misalignment / element_size) % per_line;
+            }
+        }
+        count_ = (head_ != 0 ? 1 : 0) + (size - head_ + chunk_ - 1) / chunk_;
+    }
+
+    size_t GetCount() const noexcept {
+        return count_;
+    }
+
+    size_t Begin(size_t index) const noexcept {
+        if (index == 0) {
+            return 0;
+        }
+        const size_t offset = head_ != 0 ? head_ + (index - 1) * chunk_ : index * chunk_;
+        return std::min(offset, size_);
+    }
+
+    size_t End(size_t index) const noexcept {
+        return index + 1 == count_ ? size_ : Begin(index + 1);
+    }
+
+private:
+    size_t size_;
+    size_t head_ = 0;
+    size_t chunk_ = 0;
+    size_t count_ = 1;
+};
+
+template <typename It>
+ChunkPlan MakeChunkPlan(It first, size_t size, ThreadPool& pool) {
+    using Value = typename std::iterator_traits<It>::value_type;
+    const void* base = nullptr;
+    if constexpr (std::is_pointer_v<It>) {
+        base = first;
+    }
+    return ChunkPlan(size, pool.GetThreadCount(), sizeof(Value), base);
+}
+
+// Параллельно создаёт count элементов в неинициализированной памяти dest: construct(begin, end) создаёт [begin, end).
+// Если какой-то кусок выбросил исключение, уже созданные куски разрушаются
+template <typename Type, typename Construct>
+void ParallelConstruct(Type* dest, size_t count, ThreadPool& pool, Construct construct) {
+    const ChunkPlan plan = MakeChunkPlan(dest, count, pool);
+    std::unique_ptr<bool[]> done(new bool[plan.GetCount()]());
+    try {
+        pool.RunTasks(plan.GetCount(), [&](size_t chunk) {
+            construct(plan.Begin(chunk), plan.End(chunk));
+            done[chunk] = true;
+        });
+    }
+    catch (...) {
+        for (size_t chunk = 0; chunk < plan.GetCount(); ++chunk) {
+            if (done[chunk]) {
+                std::destroy(dest + plan.Begin(chunk), dest + plan.End(chunk));
+            }
+        }
+        throw;
+    }
+}
+
+} // namespace detail
+
+// Присваивает value всем элементам [first, last)
+template <typename RandomIt, typename Type>
+void ParallelFill(RandomIt first, RandomIt last, const Type& value, ThreadPool& pool = ThreadPool::Default()) {
+    const detail::ChunkPlan plan = detail::MakeChunkPlan(first, last - first, pool);
+    pool.RunTasks(plan.GetCount(), [&](size_t chunk) {
+        std::fill(first + plan.Begin(chunk), first + plan.End(chunk), value);
+    });
+}
+
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+void ParallelFill(SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v, const Type& value, ThreadPool& pool = ThreadPool::Default()) {
+    ParallelFill(v.Data(), v.Data() + v.GetSize(), value, pool);
+}
+
+// Записывает op(*it) для каждого элемента [first, last) в out. Выходной диапазон должен вмещать результат
+template <typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt ParallelTransform(RandomIt first, RandomIt last, OutputIt out, UnaryOp op, ThreadPool& pool = ThreadPool::Default()) {
+    const size_t size = last - first;
+    const detail::ChunkPlan plan = detail::MakeChunkPlan(out, size, pool);
+    pool.RunTasks(plan.GetCount(), [&](size_t chunk) {
+        std::transform(first + plan.Begin(chunk), first + plan.End(chunk), out + plan.Begin(chunk), op);
+    });
+    return out + size;
+}
+
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename UnaryOp>
+void ParallelTransform(SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v, UnaryOp op, ThreadPool& pool = ThreadPool::Default()) {
+    ParallelTransform(v.Data(), v.Data() + v.GetSize(), v.Data(), op, pool);
+}
+
+// Сворачивает [first, last) операцией op, начиная с init. op должна быть ассоциативной:
+// куски сворачиваются независимо, а затем их результаты объединяются по порядку
+template <typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T ParallelReduce(RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp(), ThreadPool& pool = ThreadPool::Default()) {
+    const size_t size = last - first;
+    if (size == 0) {
+        return init;
+    }
+    const detail::ChunkPlan plan = detail::MakeChunkPlan(first, size, pool);
+    SimpleVector<std::optional<T>> partials(plan.GetCount());
+    pool.RunTasks(plan.GetCount(), [&](size_t chunk) {
+        auto begin = first + plan.Begin(chunk);
+        auto end = first + plan.End(chunk);
+        if (begin != end) {
+            partials[chunk] = std::accumulate(std::next(begin), end, T(*begin), op);
+        }
+    });
+    for (auto& partial : partials) {
+        if (partial) {
+            init = op(std::move(init), std::move(*partial));
+        }
+    }
+    return init;
+}
+
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename T, typename BinaryOp = std::plus<>>
+T ParallelReduce(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v, T init, BinaryOp op = BinaryOp(), ThreadPool& pool = ThreadPool::Default()) {
+    return ParallelReduce(v.Data(), v.Data() + v.GetSize(), std::move(init), op, pool);
+}
+
+// Сортирует [first, last): куски сортируются параллельно, затем попарно сливаются, пока не останется один
+template <typename RandomIt, typename Compare = std::less<>>
+void ParallelSort(RandomIt first, RandomIt last, Compare comp = Compare(), ThreadPool& pool = ThreadPool::Default()) {
+    const size_t size = last - first;
+    const detail::ChunkPlan plan = detail::MakeChunkPlan(first, size, pool);
+    const size_t chunks = plan.GetCount();
+    pool.RunTasks(chunks, [&](size_t chunk) {
+        std::sort(first + plan.Begin(chunk), first + plan.End(chunk), comp);
+    });
+    for (size_t width = 1; width < chunks; width *= 2) {
+        const size_t merges = (chunks + 2 * width - 1) / (2 * width);
+        pool.RunTasks(merges, [&](size_t merge) {
+            const size_t left = merge * 2 * width;
+            const size_t middle = std::min(left + width, chunks);
+            const size_t right = std::min(left + 2 * width, chunks);
+            if (middle < right) {
+                std::inplace_merge(first + plan.Begin(left), first + plan.Begin(middle), first + plan.End(right - 1), comp);
+            }
+        });
+    }
+}
+
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename Compare = std::less<>>
+void ParallelSort(SimpleVector<Type, Alloc, GrowthPolicy, Stats>& v, Compare comp = Compare(), ThreadPool& pool = ThreadPool::Default()) {
+    ParallelSort(v.Data(), v.Data() + v.GetSize(), comp, pool);
+}
+
+// Создаёт копию вектора, копируя элементы параллельно. Вместимость копии равна размеру исходного вектора
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats>
+SimpleVector<Type, Alloc, GrowthPolicy, Stats> ParallelCopy(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& source, ThreadPool& pool = ThreadPool::Default()) {
+    SimpleVector<Type, Alloc, GrowthPolicy, Stats> result(std::allocator_traits<Alloc>::select_on_container_copy_construction(source.GetAllocator()));
+    result.Reserve(source.GetSize());
+    result.AppendConstructed(source.GetSize(), [&](Type* dest) {
+        detail::ParallelConstruct(dest, source.GetSize(), pool, [&](size_t begin, size_t end) {
+            detail::UninitializedCopy(source.Data() + begin, source.Data() + end, dest + begin);
+        });
+    });
+    return result;
+}
+
+// Параллельный аналог SimpleVector(size, value). Каждая страница памяти впервые заполняется тем потоком,
+// который затем обычно её и обрабатывает, поэтому на NUMA-машинах она размещается на его узле (first touch)
+template <typename Type, typename Alloc = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth, typename Stats = NoStats>
+SimpleVector<Type, Alloc, GrowthPolicy, Stats> MakeParallelFilled(size_t size, const Type& value, ThreadPool& pool = ThreadPool::Default(),
+                                                           const Alloc& alloc = Alloc()) {
+    SimpleVector<Type, Alloc, GrowthPolicy, Stats> result(alloc);
+    result.Reserve(size);
+    result.AppendConstructed(size, [&](Type* dest) {
+        detail::ParallelConstruct(dest, size, pool, [&](size_t begin, size_t end) {
+            std::uninitialized_fill(dest + begin, dest + end, value);
+        });
+    });
+    return result;
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+// SimpleVectorView — невладеющее представление непрерывного диапазона элементов: указатель и размер.
+// Срезы (Subview, First, Last) ничего не копируют и не выделяют. Представление действительно, пока жив
+// диапазон, на который оно указывает; перевыделение памяти вектора делает его недействительным.
+// SimpleVectorView<const Type> (ConstSimpleVectorView<Type>) даёт доступ только для чтения
+template <typename Type>
+class SimpleVectorView {
+    using ValueType = std::remove_const_t<Type>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    SimpleVectorView() noexcept = default;
+
+    SimpleVectorView(Type* data, size_t size) noexcept
+        : data_(data)
+        , size_(size)
+    {}
+
+    SimpleVectorView(Type* first, Type* last) noexcept
+        : data_(first)
+        , size_(last - first)
+    {
+        assert(first <= last);
+    }
+
+    // Вектор неявно превращается в представление всех своих элементов
+    template <typename Alloc, typename GrowthPolicy, typename Stats>
+    SimpleVectorView(SimpleVector<ValueType, Alloc, GrowthPolicy, Stats>& v) noexcept
+        : data_(v.Data())
+        , size_(v.GetSize())
+    {}
+
+    template <typename Alloc, typename GrowthPolicy, typename Stats, typename T = Type, typename = std::enable_if_t<std::is_const_v<T>>>
+    SimpleVectorView(const SimpleVector<ValueType, Alloc, GrowthPolicy, Stats>& v) noexcept
+        : data_(v.Data())
+        , size_(v.GetSize())
+    {}
+
+    // Изменяемое представление неявно превращается в константное
+    template <typename T = Type, typename = std::enable_if_t<std::is_const_v<T>>>
+    SimpleVectorView(SimpleVectorView<ValueType> other) noexcept
+        : data_(other.begin())
+        , size_(other.GetSize())
+    {}
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index > size_");
+        }
+        return data_[index];
+    }
+
+    Iterator begin() const noexcept {
+        return data_;
+    }
+
+    Iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Представление count элементов, начиная с offset. Если элементов после offset меньше count,
+    // берутся все до конца. Выбрасывает std::out_of_range, если offset > size
+    SimpleVectorView Subview(size_t offset, size_t count = npos) const {
+        if (offset > size_) {
+            throw std::out_of_range("offset > size_");
+        }
+        return SimpleVectorView(data_ + offset, std::min(count, size_ - offset));
+    }
+
+    // Первые count элементов. Выбрасывает std::out_of_range, если count > size
+    SimpleVectorView First(size_t count) const {
+        if (count > size_) {
+            throw std::out_of_range("count > size_");
+        }
+        return SimpleVectorView(data_, count);
+    }
+
+    // Последние count элементов. Выбрасывает std::out_of_range, если count > size
+    SimpleVectorView Last(size_t count) const {
+        if (count > size_) {
+            throw std::out_of_range("count > size_");
+        }
+        return SimpleVectorView(data_ + size_ - count, count);
+    }
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Type>
+using ConstSimpleVectorView = SimpleVectorView<const Type>;
+
+namespace detail {
+
+template <typename Lhs, typename Rhs>
+using RequireSameViewValue = std::enable_if_t<std::is_same_v<std::remove_const_t<Lhs>, std::remove_const_t<Rhs>>>;
+
+} // namespace detail
+
+// Сравнения совпадают с операторами SimpleVector и принимают представления с разной константностью
+template <typename Lhs, typename Rhs, typename = detail::RequireSameViewValue<Lhs, Rhs>>
+bool operator==(SimpleVectorView<Lhs> lhs, SimpleVectorView<Rhs> rhs) {
+    return detail::RangesEqual<std::remove_const_t<Lhs>>(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Lhs, typename Rhs, typename = detail::RequireSameViewValue<Lhs, Rhs>>
+bool operator!=(SimpleVectorView<Lhs> lhs, SimpleVectorView<Rhs> rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = detail::RequireSameViewValue<Lhs, Rhs>>
+bool operator<(SimpleVectorView<Lhs> lhs, SimpleVectorView<Rhs> rhs) {
+    return detail::RangesLess<std::remove_const_t<Lhs>>(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Lhs, typename Rhs, typename = detail::RequireSameViewValue<Lhs, Rhs>>
+bool operator<=(SimpleVectorView<Lhs> lhs, SimpleVectorView<Rhs> rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Lhs, typename Rhs, typename = detail::RequireSameViewValue<Lhs, Rhs>>
+bool operator>(SimpleVectorView<Lhs> lhs, SimpleVectorView<Rhs> rhs) {
+    return rhs < lhs;
+}
+
+template <typename Lhs, typename Rhs, typename = detail::RequireSameViewValue<Lhs, Rhs>>
+bool operator>=(SimpleVectorView<Lhs> lhs, SimpleVectorView<Rhs> rhs) {
+    return !(lhs < rhs);
+}
+
+// Вектор сравнивается с представлением без построения временного представления: шаблонный вывод
+// не применяет неявное преобразование SimpleVector в SimpleVectorView, поэтому нужны отдельные перегрузки
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename View, typename = detail::RequireSameViewValue<Type, View>>
+bool operator==(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, SimpleVectorView<View> rhs) {
+    return detail::RangesEqual<Type>(lhs.Data(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename View, typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename = detail::RequireSameViewValue<Type, View>>
+bool operator==(SimpleVectorView<View> lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
+    return rhs == lhs;
+}
+
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename View, typename = detail::RequireSameViewValue<Type, View>>
+bool operator!=(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, SimpleVectorView<View> rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename View, typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename = detail::RequireSameViewValue<Type, View>>
+bool operator!=(SimpleVectorView<View> lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename View, typename = detail::RequireSameViewValue<Type, View>>
+bool operator<(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, SimpleVectorView<View> rhs) {
+    return detail::RangesLess<Type>(lhs.Data(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename View, typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename = detail::RequireSameViewValue<Type, View>>
+bool operator<(SimpleVectorView<View> lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
+    return detail::RangesLess<Type>(lhs.begin(), lhs.GetSize(), rhs.Data(), rhs.GetSize());
+}
+
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename View, typename = detail::RequireSameViewValue<Type, View>>
+bool operator<=(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, SimpleVectorView<View> rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename View, typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename = detail::RequireSameViewValue<Type, View>>
+bool operator<=(SimpleVectorView<View> lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename View, typename = detail::RequireSameViewValue<Type, View>>
+bool operator>(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, SimpleVectorView<View> rhs) {
+    return rhs < lhs;
+}
+
+template <typename View, typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename = detail::RequireSameViewValue<Type, View>>
+bool operator>(SimpleVectorView<View> lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename View, typename = detail::RequireSameViewValue<Type, View>>
+bool operator>=(const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& lhs, SimpleVectorView<View> rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename View, typename Type, typename Alloc, typename GrowthPolicy, typename Stats, typename = detail::RequireSameViewValue<Type, View>>
+bool operator>=(SimpleVectorView<View> lhs, const SimpleVector<Type, Alloc, GrowthPolicy, Stats>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,399 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// SmallSimpleVector — вектор с тем же интерфейсом, что и SimpleVector, хранящий до N элементов
+// во встроенном буфере внутри самого объекта. Куча используется, только когда элементов становится больше N.
+// Рост вместимости за пределами встроенного буфера и перенос элементов выполняются теми же правилами, что и в SimpleVector
+template <typename Type, size_t N, typename GrowthPolicy = DoublingGrowth>
+class SmallSimpleVector {
+    static_assert(N > 0, "SmallSimpleVector requires non-zero inline capacity");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Создаёт пустой вектор со встроенной вместимостью N. Не выделяет динамическую память
+    SmallSimpleVector() noexcept
+        : data_(InlineData())
+    {}
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SmallSimpleVector(size_t size)
+        : SmallSimpleVector()
+    {
+        Reserve(size);
+        std::uninitialized_value_construct_n(data_, size);
+        size_ = size;
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SmallSimpleVector(size_t size, const Type& value)
+        : SmallSimpleVector()
+    {
+        Reserve(size);
+        std::uninitialized_fill_n(data_, size, value);
+        size_ = size;
+    }
+
+    SmallSimpleVector(std::initializer_list<Type> init)
+        : SmallSimpleVector()
+    {
+        Reserve(init.size());
+        std::uninitialized_copy(init.begin(), init.end(), data_);
+        size_ = init.size();
+    }
+
+    SmallSimpleVector(const SmallSimpleVector& other)
+        : SmallSimpleVector()
+    {
+        Reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    SmallSimpleVector(ReserveProxyObj obj)
+        : SmallSimpleVector()
+    {
+        Reserve(obj.capacity_to_reserve_);
+    }
+
+    // Память в куче забирается целиком, элементы встроенного буфера переносятся по одному
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>)
+        : SmallSimpleVector()
+    {
+        MoveFrom(other);
+    }
+
+    ~SmallSimpleVector() {
+        std::destroy_n(data_, size_);
+    }
+
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs) {
+        if (this != &rhs) {
+            SmallSimpleVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            Clear();
+            MoveFrom(rhs);
+        }
+        return *this;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return IsInline() ? N : heap_.GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Сообщает, находятся ли элементы во встроенном буфере
+    bool IsInline() const noexcept {
+        return data_ == InlineData();
+    }
+
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("index > size_");
+        }
+        return data_[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index > size_");
+        }
+        return data_[index];
+    }
+
+    // Разрушает элементы, не изменяя вместимость
+    void Clear() noexcept {
+        std::destroy_n(data_, size_);
+        size_ = 0;
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            std::destroy(data_ + new_size, data_ + size_);
+        }
+        else if (new_size > size_) {
+            if (new_size > GetCapacity()) {
+                Reallocate(GrowthPolicy::NextCapacity(GetCapacity(), new_size, sizeof(Type)));
+            }
+            std::uninitialized_value_construct(data_ + size_, data_ + new_size);
+        }
+        size_ = new_size;
+    }
+
+    Iterator begin() noexcept {
+        return data_;
+    }
+
+    Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            EmplaceWithReallocation(size_, std::forward<Args>(args)...);
+        }
+        else {
+            new (data_ + size_) Type(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        size_t count = pos - begin();
+        if (size_ == GetCapacity()) {
+            EmplaceWithReallocation(count, std::forward<Args>(args)...);
+        }
+        else if (count == size_) {
+            new (data_ + size_) Type(std::forward<Args>(args)...);
+        }
+        else {
+            detail::EmplaceShifting(data_, size_, count, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return begin() + count;
+    }
+
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        std::destroy_at(data_ + size_);
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        assert(pos != end());
+        assert(pos >= begin());
+
+        size_t count = pos - begin();
+        detail::EraseShifting(data_, size_, count);
+        --size_;
+        return begin() + count;
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(begin() <= first && first <= last && last <= end());
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        if (count != 0) {
+            detail::EraseRangeShifting(data_, size_, index, count);
+            size_ -= count;
+        }
+        return begin() + index;
+    }
+
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        const size_t old_size = size_;
+        size_ = detail::RemoveIfCompacting(data_, size_, pred);
+        return old_size - size_;
+    }
+
+    Iterator SwapRemove(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+        const size_t index = pos - begin();
+        detail::SwapRemoveLast(data_, size_, index);
+        --size_;
+        return begin() + index;
+    }
+
+    // Если оба вектора в куче, обмениваются только указатели. Иначе элементы переносятся через временный вектор
+    void swap(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (!IsInline() && !other.IsInline()) {
+            heap_.swap(other.heap_);
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+        }
+        else {
+            SmallSimpleVector temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Уменьшает вместимость до размера. Если элементы помещаются во встроенный буфер, они переносятся в него,
+    // а память в куче освобождается
+    void ShrinkToFit() {
+        if (IsInline() || size_ == heap_.GetCapacity()) {
+            return;
+        }
+        if (size_ <= N) {
+            detail::RelocateElements(data_, size_, InlineData());
+            RawStorage<Type> empty;
+            heap_.swap(empty);
+            data_ = InlineData();
+        }
+        else {
+            Reallocate(size_);
+        }
+    }
+
+    // Разрушает элементы и освобождает память в куче, возвращая вектор во встроенный буфер
+    void Reset() noexcept {
+        Clear();
+        RawStorage<Type> empty;
+        heap_.swap(empty);
+        data_ = InlineData();
+    }
+
+private:
+    // Ячейки встроенного буфера конструируются только в пределах [0, size_), пока data_ указывает на него
+    alignas(Type) unsigned char inline_buffer_[sizeof(Type) * N];
+    Type* data_;
+    size_t size_ = 0;
+    // Пуст, пока элементы помещаются во встроенный буфер
+    RawStorage<Type> heap_;
+
+    Type* InlineData() noexcept {
+        return reinterpret_cast<Type*>(inline_buffer_);
+    }
+
+    const Type* InlineData() const noexcept {
+        return reinterpret_cast<const Type*>(inline_buffer_);
+    }
+
+    // Переносит элементы в кучу вместимостью new_capacity > N
+    void Reallocate(size_t new_capacity) {
+        assert(new_capacity > N);
+        RawStorage<Type> temp(new_capacity);
+        detail::RelocateElements(data_, size_, temp.Get());
+        AdoptHeap(temp);
+    }
+
+    template <typename... Args>
+    void EmplaceWithReallocation(size_t index, Args&&... args) {
+        RawStorage<Type> temp(GrowthPolicy::NextCapacity(GetCapacity(), size_ + 1, sizeof(Type)));
+        // Элемент создаётся до переноса старых, поэтому args могут ссылаться на элементы самого вектора
+        new (temp + index) Type(std::forward<Args>(args)...);
+        detail::RelocateAroundGap(data_, size_, temp.Get(), index);
+        AdoptHeap(temp);
+    }
+
+    void AdoptHeap(RawStorage<Type>& temp) noexcept {
+        heap_.swap(temp);
+        data_ = heap_.Get();
+    }
+
+    // Забирает элементы other, оставляя его пустым. Этот вектор должен быть пуст
+    void MoveFrom(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        assert(size_ == 0);
+        if (!other.IsInline()) {
+            heap_ = std::move(other.heap_);
+            data_ = heap_.Get();
+            size_ = std::exchange(other.size_, 0);
+            other.data_ = other.InlineData();
+        }
+        else {
+            // Элементов не больше N, поэтому они поместятся и во встроенный буфер, и в уже выделенную кучу
+            std::uninitialized_move_n(other.data_, other.size_, data_);
+            size_ = other.size_;
+            other.Clear();
+        }
+    }
+};
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator==(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    if (&lhs == &rhs) {
+        return true;
+    }
+    return detail::RangesEqual(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+bool operator!=(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+bool operator<(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return detail::RangesLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+bool operator<=(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+bool operator>(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return (rhs < lhs);
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+bool operator>=(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,419 @@
+#pragma once
+
+#include "growth_policy.h"
+#include "raw_storage.h"
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// BasicSoaSimpleVector — вектор записей из полей Ts..., хранящий каждое поле в отдельном столбце (structure of arrays).
+// Цикл, которому нужно одно-два поля, читает только их столбцы, и каждая загруженная кэш-линия целиком занята нужными данными.
+// Все столбцы имеют общие размер и вместимость и растут вместе по правилам GrowthPolicy.
+// Элемент представлен кортежем ссылок std::tuple<Ts&...>; итератор выдаёт такие кортежи, как прокси-итератор std::vector<bool>.
+// Перенос столбцов при росте не должен выбрасывать исключений, поэтому поля должны быть
+// тривиально перемещаемыми или иметь noexcept-конструктор перемещения
+template <typename GrowthPolicy, typename... Ts>
+class BasicSoaSimpleVector {
+    static_assert(sizeof...(Ts) > 0, "SoaSimpleVector needs at least one field");
+    static_assert(((IsTriviallyRelocatable<Ts>::value || std::is_nothrow_move_constructible_v<Ts>) && ...),
+                  "SoaSimpleVector fields must be relocatable without exceptions");
+
+    static constexpr size_t kColumnCount = sizeof...(Ts);
+    using Indices = std::index_sequence_for<Ts...>;
+
+public:
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    using Reference = std::tuple<Ts&...>;
+    using ConstReference = std::tuple<const Ts&...>;
+
+    // Итератор по записям. Разыменование даёт кортеж ссылок на поля записи
+    template <bool IsConst>
+    class ZipIterator {
+        template <typename T>
+        using Pointer = std::conditional_t<IsConst, const T*, T*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::tuple<Ts...>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, ConstReference, Reference>;
+        using pointer = void;
+
+        ZipIterator() noexcept = default;
+
+        ZipIterator(std::tuple<Pointer<Ts>...> columns, size_t index) noexcept
+            : columns_(columns)
+            , index_(index)
+        {}
+
+        // Изменяемый итератор неявно превращается в константный
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        ZipIterator(const ZipIterator<OtherConst>& other) noexcept
+            : columns_(other.columns_)
+            , index_(other.index_)
+        {}
+
+        reference operator*() const noexcept {
+            return std::apply([this](auto... columns) {
+                return reference(columns[index_]...);
+            }, columns_);
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        ZipIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        ZipIterator operator++(int) noexcept {
+            ZipIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        ZipIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        ZipIterator operator--(int) noexcept {
+            ZipIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        ZipIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        ZipIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend ZipIterator operator+(ZipIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend ZipIterator operator+(difference_type offset, ZipIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend ZipIterator operator-(ZipIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const ZipIterator& lhs, const ZipIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        template <bool>
+        friend class ZipIterator;
+
+        std::tuple<Pointer<Ts>...> columns_{};
+        size_t index_ = 0;
+    };
+
+    using Iterator = ZipIterator<false>;
+    using ConstIterator = ZipIterator<true>;
+
+    BasicSoaSimpleVector() noexcept = default;
+
+    // Создаёт size записей, поля которых инициализированы значением по умолчанию
+    explicit BasicSoaSimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    BasicSoaSimpleVector(ReserveProxyObj obj) {
+        Reserve(obj.capacity_to_reserve_);
+    }
+
+    BasicSoaSimpleVector(const BasicSoaSimpleVector& other) {
+        Reserve(other.size_);
+        CopyColumns(other, Indices());
+        size_ = other.size_;
+    }
+
+    BasicSoaSimpleVector(BasicSoaSimpleVector&& other) noexcept
+        : columns_(std::move(other.columns_))
+        , size_(std::exchange(other.size_, 0))
+    {}
+
+    ~BasicSoaSimpleVector() {
+        DestroyRange(0, size_, Indices());
+    }
+
+    BasicSoaSimpleVector& operator=(const BasicSoaSimpleVector& rhs) {
+        if (this != &rhs) {
+            BasicSoaSimpleVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    BasicSoaSimpleVector& operator=(BasicSoaSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            BasicSoaSimpleVector temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return std::get<0>(columns_).GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return *(begin() + index);
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return *(begin() + index);
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Reference At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("index > size_");
+        }
+        return (*this)[index];
+    }
+
+    ConstReference At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index > size_");
+        }
+        return (*this)[index];
+    }
+
+    // Столбец поля I как непрерывный массив. Представление действительно до перевыделения памяти
+    template <size_t I>
+    SimpleVectorView<FieldType<I>> Column() noexcept {
+        return SimpleVectorView<FieldType<I>>(std::get<I>(columns_).Get(), size_);
+    }
+
+    template <size_t I>
+    ConstSimpleVectorView<FieldType<I>> Column() const noexcept {
+        return ConstSimpleVectorView<FieldType<I>>(std::get<I>(columns_).Get(), size_);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(ColumnPointers(Indices()), 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(ColumnPointers(Indices()), size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(ColumnPointers(Indices()), 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(ColumnPointers(Indices()), size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    void Clear() noexcept {
+        DestroyRange(0, size_, Indices());
+        size_ = 0;
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyRange(new_size, size_, Indices());
+        }
+        else if (new_size > size_) {
+            if (new_size > GetCapacity()) {
+                Reallocate(GrowthPolicy::NextCapacity(GetCapacity(), new_size, kRecordSize));
+            }
+            for (size_t index = size_; index < new_size; ++index) {
+                // size_ растёт по одной записи, чтобы исключение не оставило недостроенных записей
+                ConstructAt(index, std::tuple<>(), Indices(), std::true_type());
+                ++size_;
+            }
+        }
+        size_ = new_size;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    void PushBack(const std::tuple<Ts...>& record) {
+        EmplaceFromTuple(record);
+    }
+
+    void PushBack(std::tuple<Ts...>&& record) {
+        EmplaceFromTuple(std::move(record));
+    }
+
+    // Создаёт запись, передавая каждому полю свой аргумент: EmplaceBack(x, y, z)
+    template <typename... Args, typename = std::enable_if_t<sizeof...(Args) == kColumnCount>>
+    Reference EmplaceBack(Args&&... args) {
+        EmplaceFromTuple(std::forward_as_tuple(std::forward<Args>(args)...));
+        return (*this)[size_ - 1];
+    }
+
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        DestroyRange(size_, size_ + 1, Indices());
+    }
+
+    void swap(BasicSoaSimpleVector& other) noexcept {
+        SwapColumns(other.columns_, Indices());
+        std::swap(size_, other.size_);
+    }
+
+private:
+    static constexpr size_t kRecordSize = (sizeof(Ts) + ...);
+
+    std::tuple<RawStorage<Ts>...> columns_;
+    size_t size_ = 0;
+
+    template <size_t... I>
+    std::tuple<Ts*...> ColumnPointers(std::index_sequence<I...>) noexcept {
+        return { std::get<I>(columns_).Get()... };
+    }
+
+    template <size_t... I>
+    std::tuple<const Ts*...> ColumnPointers(std::index_sequence<I...>) const noexcept {
+        return { std::get<I>(columns_).Get()... };
+    }
+
+    template <size_t... I>
+    void DestroyRange(size_t first, size_t last, std::index_sequence<I...>) noexcept {
+        (std::destroy(std::get<I>(columns_) + first, std::get<I>(columns_) + last), ...);
+    }
+
+    // Создаёт поля записи index, начиная с поля I, из элементов кортежа values (или значением по умолчанию,
+    // если values пуст). Если поле выбросило исключение, уже созданные поля записи разрушаются
+    template <typename Values, size_t I, size_t... Rest, bool ValueInit>
+    void ConstructAt(size_t index, Values&& values, std::index_sequence<I, Rest...>, std::bool_constant<ValueInit> value_init) {
+        if constexpr (ValueInit) {
+            new (std::get<I>(columns_) + index) FieldType<I>();
+        }
+        else {
+            new (std::get<I>(columns_) + index) FieldType<I>(std::get<I>(std::forward<Values>(values)));
+        }
+        if constexpr (sizeof...(Rest) != 0) {
+            try {
+                ConstructAt(index, std::forward<Values>(values), std::index_sequence<Rest...>(), value_init);
+            }
+            catch (...) {
+                std::destroy_at(std::get<I>(columns_) + index);
+                throw;
+            }
+        }
+    }
+
+    template <typename Record>
+    void EmplaceFromTuple(Record&& record) {
+        if (size_ == GetCapacity()) {
+            // Поля копируются до перевыделения, так как record может ссылаться на записи самого вектора
+            std::tuple<Ts...> values(std::forward<Record>(record));
+            Reallocate(GrowthPolicy::NextCapacity(GetCapacity(), size_ + 1, kRecordSize));
+            ConstructAt(size_, std::move(values), Indices(), std::false_type());
+        }
+        else {
+            ConstructAt(size_, std::forward<Record>(record), Indices(), std::false_type());
+        }
+        ++size_;
+    }
+
+    // Сначала выделяется память под все столбцы, и только затем они переносятся: перенос не выбрасывает исключений
+    void Reallocate(size_t new_capacity) {
+        std::tuple<RawStorage<Ts>...> temp{ RawStorage<Ts>(new_capacity)... };
+        RelocateColumns(temp, Indices());
+        SwapColumns(temp, Indices());
+    }
+
+    template <size_t... I>
+    void RelocateColumns(std::tuple<RawStorage<Ts>...>& to, std::index_sequence<I...>) noexcept {
+        (detail::RelocateElements(std::get<I>(columns_).Get(), size_, std::get<I>(to).Get()), ...);
+    }
+
+    // Копирует столбцы other. Если копирование поля выбросило исключение, созданные копии разрушаются
+    template <size_t... I>
+    void CopyColumns(const BasicSoaSimpleVector& other, std::index_sequence<I...>) {
+        size_t copied = 0;
+        try {
+            ((detail::UninitializedCopy(std::get<I>(other.columns_).Get(), std::get<I>(other.columns_).Get() + other.size_,
+                                        std::get<I>(columns_).Get()),
+              ++copied),
+             ...);
+        }
+        catch (...) {
+            ((I < copied ? static_cast<void>(std::destroy_n(std::get<I>(columns_).Get(), other.size_)) : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void SwapColumns(std::tuple<RawStorage<Ts>...>& other, std::index_sequence<I...>) noexcept {
+        (std::get<I>(columns_).swap(std::get<I>(other)), ...);
+    }
+};
+
+template <typename... Ts>
+using SoaSimpleVector = BasicSoaSimpleVector<DoublingGrowth, Ts...>;
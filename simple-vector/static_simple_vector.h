@@ -0,0 +1,397 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+
+// Тривиальные элементы хранятся обычным массивом, который можно создавать и изменять в constexpr-функциях.
+// Тогда и сам StaticSimpleVector остаётся литеральным типом с тривиальными копированием и деструктором
+template <typename Type>
+inline constexpr bool kConstexprStorage = std::is_trivial_v<Type> && std::is_trivially_copy_assignable_v<Type>;
+
+template <typename Type, size_t N, bool = kConstexprStorage<Type>>
+class StaticStorage {
+public:
+    constexpr Type* Data() noexcept {
+        return items_.data();
+    }
+
+    constexpr const Type* Data() const noexcept {
+        return items_.data();
+    }
+
+    // Размещающий new недоступен в constexpr-функциях, поэтому ячейка получает значение присваиванием
+    template <typename... Args>
+    constexpr void Construct(size_t index, Args&&... args) {
+        items_[index] = Type(std::forward<Args>(args)...);
+    }
+
+    constexpr void Destroy(size_t /*first*/, size_t /*last*/) noexcept {}
+
+    size_t size_ = 0;
+
+private:
+    std::array<Type, N> items_{};
+};
+
+// Остальные элементы создаются размещающим new в неинициализированном буфере
+template <typename Type, size_t N>
+class StaticStorage<Type, N, false> {
+public:
+    StaticStorage() noexcept = default;
+
+    StaticStorage(const StaticStorage& other) {
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    // Элементы other переносятся поштучно; сам other сохраняет перемещённые элементы
+    StaticStorage(StaticStorage&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        std::uninitialized_move_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    // Если копирование выбросит исключение, приёмник останется пустым
+    StaticStorage& operator=(const StaticStorage& rhs) {
+        if (this != &rhs) {
+            Destroy(0, std::exchange(size_, 0));
+            std::uninitialized_copy_n(rhs.Data(), rhs.size_, Data());
+            size_ = rhs.size_;
+        }
+        return *this;
+    }
+
+    StaticStorage& operator=(StaticStorage&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            Destroy(0, std::exchange(size_, 0));
+            std::uninitialized_move_n(rhs.Data(), rhs.size_, Data());
+            size_ = rhs.size_;
+        }
+        return *this;
+    }
+
+    ~StaticStorage() {
+        Destroy(0, size_);
+    }
+
+    Type* Data() noexcept {
+        return std::launder(reinterpret_cast<Type*>(buffer_));
+    }
+
+    const Type* Data() const noexcept {
+        return std::launder(reinterpret_cast<const Type*>(buffer_));
+    }
+
+    template <typename... Args>
+    void Construct(size_t index, Args&&... args) {
+        new (Data() + index) Type(std::forward<Args>(args)...);
+    }
+
+    void Destroy(size_t first, size_t last) noexcept {
+        std::destroy(Data() + first, Data() + last);
+    }
+
+    size_t size_ = 0;
+
+private:
+    alignas(Type) unsigned char buffer_[N == 0 ? 1 : N * sizeof(Type)];
+};
+
+} // namespace detail
+
+// StaticSimpleVector — вектор вместимостью ровно N элементов, хранящихся внутри самого объекта.
+// Он никогда не обращается к куче, поэтому годится для потоков, где выделять память запрещено.
+// Переполнение не приводит к выделению памяти: PushBack и EmplaceBack выбрасывают std::length_error,
+// а TryPushBack и TryEmplaceBack сообщают о нём возвращаемым значением.
+// Итераторы — указатели, как у SimpleVector, а сравнения выполняются теми же функциями.
+//
+// Для тривиальных типов создание, добавление, удаление с конца, доступ и итерация — constexpr,
+// так что таблицы можно строить при компиляции:
+//     constexpr auto kTable = [] { StaticSimpleVector<int, 256> t; ...; return t; }();
+template <typename Type, size_t N>
+class StaticSimpleVector {
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    constexpr StaticSimpleVector() noexcept = default;
+
+    // Создаёт size элементов, инициализированных значением по умолчанию. Выбрасывает std::length_error, если size > N
+    constexpr explicit StaticSimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    constexpr StaticSimpleVector(size_t size, const Type& value) {
+        CheckFits(size);
+        while (storage_.size_ < size) {
+            storage_.Construct(storage_.size_, value);
+            ++storage_.size_;
+        }
+    }
+
+    constexpr StaticSimpleVector(std::initializer_list<Type> init) {
+        CheckFits(init.size());
+        for (const Type& item : init) {
+            storage_.Construct(storage_.size_, item);
+            ++storage_.size_;
+        }
+    }
+
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    constexpr StaticSimpleVector(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            EmplaceBack(*first);
+        }
+    }
+
+    static constexpr size_t GetCapacity() noexcept {
+        return N;
+    }
+
+    constexpr size_t GetSize() const noexcept {
+        return storage_.size_;
+    }
+
+    constexpr bool IsEmpty() const noexcept {
+        return storage_.size_ == 0;
+    }
+
+    constexpr bool IsFull() const noexcept {
+        return storage_.size_ == N;
+    }
+
+    constexpr Type& operator[](size_t index) noexcept {
+        assert(index < storage_.size_);
+        return storage_.Data()[index];
+    }
+
+    constexpr const Type& operator[](size_t index) const noexcept {
+        assert(index < storage_.size_);
+        return storage_.Data()[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    constexpr Type& At(size_t index) {
+        if (index >= storage_.size_) {
+            throw std::out_of_range("index > size_");
+        }
+        return storage_.Data()[index];
+    }
+
+    constexpr const Type& At(size_t index) const {
+        if (index >= storage_.size_) {
+            throw std::out_of_range("index > size_");
+        }
+        return storage_.Data()[index];
+    }
+
+    constexpr Iterator begin() noexcept {
+        return storage_.Data();
+    }
+
+    constexpr Iterator end() noexcept {
+        return storage_.Data() + storage_.size_;
+    }
+
+    constexpr ConstIterator begin() const noexcept {
+        return storage_.Data();
+    }
+
+    constexpr ConstIterator end() const noexcept {
+        return storage_.Data() + storage_.size_;
+    }
+
+    constexpr ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    constexpr ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    constexpr void Clear() noexcept {
+        storage_.Destroy(0, storage_.size_);
+        storage_.size_ = 0;
+    }
+
+    // Выбрасывает std::length_error, если new_size > N
+    constexpr void Resize(size_t new_size) {
+        CheckFits(new_size);
+        if (new_size < storage_.size_) {
+            storage_.Destroy(new_size, storage_.size_);
+            storage_.size_ = new_size;
+        }
+        while (storage_.size_ < new_size) {
+            storage_.Construct(storage_.size_);
+            ++storage_.size_;
+        }
+    }
+
+    // Выбрасывает std::length_error, если вектор заполнен
+    constexpr void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    constexpr void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    constexpr Type& EmplaceBack(Args&&... args) {
+        CheckFits(storage_.size_ + 1);
+        return EmplaceBackUnchecked(std::forward<Args>(args)...);
+    }
+
+    // Добавляет элемент, если есть место, и сообщает, удалось ли это
+    constexpr bool TryPushBack(const Type& item) {
+        return TryEmplaceBack(item) != nullptr;
+    }
+
+    constexpr bool TryPushBack(Type&& item) {
+        return TryEmplaceBack(std::move(item)) != nullptr;
+    }
+
+    // Возвращает указатель на созданный элемент или nullptr, если вектор заполнен
+    template <typename... Args>
+    constexpr Type* TryEmplaceBack(Args&&... args) {
+        if (IsFull()) {
+            return nullptr;
+        }
+        return &EmplaceBackUnchecked(std::forward<Args>(args)...);
+    }
+
+    constexpr void PopBack() noexcept {
+        assert(!IsEmpty());
+        --storage_.size_;
+        storage_.Destroy(storage_.size_, storage_.size_ + 1);
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Создаёт элемент в позиции pos. Выбрасывает std::length_error, если вектор заполнен
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        CheckFits(storage_.size_ + 1);
+        const size_t index = pos - begin();
+        if (index == storage_.size_) {
+            storage_.Construct(index, std::forward<Args>(args)...);
+        }
+        else {
+            detail::EmplaceShifting(storage_.Data(), storage_.size_, index, std::forward<Args>(args)...);
+        }
+        ++storage_.size_;
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+        const size_t index = pos - begin();
+        detail::EraseShifting(storage_.Data(), storage_.size_, index);
+        --storage_.size_;
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(begin() <= first && first <= last && last <= end());
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        if (count != 0) {
+            detail::EraseRangeShifting(storage_.Data(), storage_.size_, index, count);
+            storage_.size_ -= count;
+        }
+        return begin() + index;
+    }
+
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        const size_t old_size = storage_.size_;
+        storage_.size_ = detail::RemoveIfCompacting(storage_.Data(), storage_.size_, pred);
+        return old_size - storage_.size_;
+    }
+
+    Iterator SwapRemove(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+        const size_t index = pos - begin();
+        detail::SwapRemoveLast(storage_.Data(), storage_.size_, index);
+        --storage_.size_;
+        return begin() + index;
+    }
+
+    // Элементы хранятся внутри объектов, поэтому обмен поэлементный и стоит O(N)
+    void swap(StaticSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_swappable_v<Type>) {
+        StaticSimpleVector& shorter = GetSize() < other.GetSize() ? *this : other;
+        StaticSimpleVector& longer = GetSize() < other.GetSize() ? other : *this;
+        const size_t common = shorter.GetSize();
+        for (size_t index = 0; index < common; ++index) {
+            using std::swap;
+            swap(shorter[index], longer[index]);
+        }
+        for (size_t index = common; index < longer.GetSize(); ++index) {
+            shorter.EmplaceBackUnchecked(std::move(longer[index]));
+        }
+        longer.storage_.Destroy(common, longer.storage_.size_);
+        longer.storage_.size_ = common;
+    }
+
+private:
+    detail::StaticStorage<Type, N> storage_;
+
+    static constexpr void CheckFits(size_t size) {
+        if (size > N) {
+            throw std::length_error("StaticSimpleVector capacity exceeded");
+        }
+    }
+
+    template <typename... Args>
+    constexpr Type& EmplaceBackUnchecked(Args&&... args) {
+        storage_.Construct(storage_.size_, std::forward<Args>(args)...);
+        return storage_.Data()[storage_.size_++];
+    }
+};
+
+template <typename Type, size_t N>
+bool operator==(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return detail::RangesEqual(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type, size_t N>
+bool operator!=(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+bool operator<(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return detail::RangesLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type, size_t N>
+bool operator<=(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+bool operator>(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N>
+bool operator>=(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Политики статистики для SimpleVector. Политика — это тип со статическими методами
+//     static void OnAllocate(size_t old_capacity, size_t new_capacity, size_t element_size) noexcept;
+//     static void OnRelocate(size_t count, size_t element_size) noexcept;
+//     static void OnCopy(size_t count, size_t element_size) noexcept;
+// которые вектор вызывает при выделении блока памяти (old_capacity == 0 для первого блока, иначе это перевыделение),
+// переносе элементов в новую память и копировании элементов из другого вектора или диапазона.
+// Политика NoStats используется по умолчанию, её пустые методы встраиваются и исчезают при компиляции
+
+struct NoStats {
+    static void OnAllocate(size_t /*old_capacity*/, size_t /*new_capacity*/, size_t /*element_size*/) noexcept {}
+    static void OnRelocate(size_t /*count*/, size_t /*element_size*/) noexcept {}
+    static void OnCopy(size_t /*count*/, size_t /*element_size*/) noexcept {}
+};
+
+// Снимок счётчиков VectorStats
+struct StatsSnapshot {
+    // Количество выделенных блоков, включая перевыделения
+    uint64_t allocations = 0;
+    // Сколько из них заменили уже существующий блок при росте или сжатии
+    uint64_t reallocations = 0;
+    uint64_t bytes_allocated = 0;
+    // Элементы, перенесённые в новую память при перевыделении
+    uint64_t elements_relocated = 0;
+    uint64_t bytes_relocated = 0;
+    uint64_t elements_copied = 0;
+    // Наибольшая вместимость среди всех векторов с этой меткой
+    uint64_t peak_capacity = 0;
+    // growth_histogram[k] — количество выделений вместимостью из [2^k, 2^(k+1))
+    std::array<uint64_t, 64> growth_histogram{};
+};
+
+// Собирает статистику всех векторов, объявленных с одной меткой Tag. Метка обычно — пустая структура
+// на каждое место использования, например VectorStats<struct RoutesTag>. Счётчики атомарны,
+// поэтому векторы с одной меткой можно использовать из разных потоков
+template <typename Tag = void>
+class VectorStats {
+public:
+    static void OnAllocate(size_t old_capacity, size_t new_capacity, size_t element_size) noexcept {
+        Add(counters_.allocations, 1);
+        if (old_capacity != 0) {
+            Add(counters_.reallocations, 1);
+        }
+        Add(counters_.bytes_allocated, new_capacity * element_size);
+        Add(counters_.growth_histogram[Log2(new_capacity)], 1);
+        uint64_t peak = counters_.peak_capacity.load(std::memory_order_relaxed);
+        while (peak < new_capacity && !counters_.peak_capacity.compare_exchange_weak(peak, new_capacity, std::memory_order_relaxed)) {
+        }
+    }
+
+    static void OnRelocate(size_t count, size_t element_size) noexcept {
+        Add(counters_.elements_relocated, count);
+        Add(counters_.bytes_relocated, count * element_size);
+    }
+
+    static void OnCopy(size_t count, size_t /*element_size*/) noexcept {
+        Add(counters_.elements_copied, count);
+    }
+
+    static StatsSnapshot Snapshot() noexcept {
+        StatsSnapshot snapshot;
+        snapshot.allocations = counters_.allocations.load(std::memory_order_relaxed);
+        snapshot.reallocations = counters_.reallocations.load(std::memory_order_relaxed);
+        snapshot.bytes_allocated = counters_.bytes_allocated.load(std::memory_order_relaxed);
+        snapshot.elements_relocated = counters_.elements_relocated.load(std::memory_order_relaxed);
+        snapshot.bytes_relocated = counters_.bytes_relocated.load(std::memory_order_relaxed);
+        snapshot.elements_copied = counters_.elements_copied.load(std::memory_order_relaxed);
+        snapshot.peak_capacity = counters_.peak_capacity.load(std::memory_order_relaxed);
+        for (size_t k = 0; k < snapshot.growth_histogram.size(); ++k) {
+            snapshot.growth_histogram[k] = counters_.growth_histogram[k].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    static void Reset() noexcept {
+        for (auto* counter : { &counters_.allocations, &counters_.reallocations, &counters_.bytes_allocated, &counters_.elements_relocated,
+                               &counters_.bytes_relocated, &counters_.elements_copied, &counters_.peak_capacity }) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+        for (auto& bucket : counters_.growth_histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> reallocations{ 0 };
+        std::atomic<uint64_t> bytes_allocated{ 0 };
+        std::atomic<uint64_t> elements_relocated{ 0 };
+        std::atomic<uint64_t> bytes_relocated{ 0 };
+        std::atomic<uint64_t> elements_copied{ 0 };
+        std::atomic<uint64_t> peak_capacity{ 0 };
+        std::array<std::atomic<uint64_t>, 64> growth_histogram{};
+    };
+
+    static inline Counters counters_;
+
+    static void Add(std::atomic<uint64_t>& counter, uint64_t value) noexcept {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    static size_t Log2(size_t value) noexcept {
+        size_t log = 0;
+        while (value > 1) {
+            value >>= 1;
+            ++log;
+        }
+        return log;
+    }
+};